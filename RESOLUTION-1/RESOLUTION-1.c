@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -28,6 +29,30 @@
 // tGrille est un tableau de TAILLE lignes et TAILLE colonnes contenant la grille de jeu initiale
 typedef int tGrille[TAILLE][TAILLE];
 
+// tMasque est un ensemble de valeurs : le bit (valeur-1) est a 1 si la valeur appartient a l ensemble
+typedef unsigned long long tMasque;
+
+/**
+ * \def TOUTES_VALEURS
+ * \brief Masque contenant toutes les valeurs de 1 a TAILLE
+*/
+#define TOUTES_VALEURS (~0ULL >> (64 - TAILLE))
+
+/**
+ * \struct tContraintes
+ * \brief Structure representant les valeurs deja utilisees dans la grille
+ * 
+ * La structure tContraintes contient :
+ * - lignes : pour chaque ligne, le masque des valeurs deja placees
+ * - colonnes : pour chaque colonne, le masque des valeurs deja placees
+ * - blocs : pour chaque bloc, le masque des valeurs deja placees
+*/
+typedef struct {
+    tMasque lignes[TAILLE];
+    tMasque colonnes[TAILLE];
+    tMasque blocs[TAILLE];
+} tContraintes;
+
 
 /**
  * \def CELLULE_VIDE
@@ -36,11 +61,15 @@ typedef int tGrille[TAILLE][TAILLE];
 const char CELLULE_VIDE = '.' ;
 
 
-bool absentSurLigne(int valeur, tGrille grille, int numLigne);
-bool absentSurColonne(int valeur, tGrille grille, int numColonne);
-bool absentSurBloc(int valeur, tGrille grille, int numLigne, int numColonne);
+int numeroBloc(int numLigne, int numColonne);
+void initContraintes(tContraintes *contraintes, tGrille grille);
+tMasque valeursAutorisees(tContraintes *contraintes, int numLigne, int numColonne);
+void placerValeur(tGrille grille, tContraintes *contraintes, int numLigne, int numColonne, int valeur);
+void enleverValeur(tGrille grille, tContraintes *contraintes, int numLigne, int numColonne, int valeur);
 
-bool backtracking(tGrille grille, int numCase);
+bool backtracking(tGrille grille, tContraintes *contraintes, int numCase);
+int caseMoinsContrainte(tGrille grille, tContraintes *contraintes, tMasque *autorisees);
+bool backtrackingMRV(tGrille grille, tContraintes *contraintes);
 
 int premiereCaseVide(tGrille grille);
 
@@ -55,8 +84,13 @@ void afficherGrille(tGrille grille);
  *                PROGRAMME PRINCIPAL                *
  *****************************************************/
 
-int main() {
+int main(int argc, char *argv[]) {
     tGrille grille;
+    tContraintes contraintes;
+
+    // ordre de parcours des cases : ligne par ligne par defaut,
+    // case la plus contrainte d abord (MRV) avec l option --mrv
+    bool mrv = (argc > 1 && strcmp(argv[1], "--mrv") == 0);
 
     chargerGrille(grille);
 
@@ -65,7 +99,12 @@ int main() {
 
     clock_t start = clock();
 
-    backtracking(grille, premiereCaseVide(grille));
+    initContraintes(&contraintes, grille);
+    if (mrv) {
+        backtrackingMRV(grille, &contraintes);
+    } else {
+        backtracking(grille, &contraintes, premiereCaseVide(grille));
+    }
 
     clock_t end = clock();
     double time_spent = (double)(end - start) / CLOCKS_PER_SEC;
@@ -78,95 +117,117 @@ int main() {
 }
 
 /**
- * \fn bool absentSurLigne(int valeur, tGrille grille, int numLigne
- * \brief Verifie si une valeur est absente sur une ligne
- * \param valeur Valeur dont on veut verifier l absence sur la ligne
- * \param grille Grille de jeu
+ * \fn int numeroBloc(int numLigne, int numColonne)
+ * \brief Determine le numero du bloc contenant une case
  * \param numLigne Numero de la ligne de la case selectionnee
+ * \param numColonne Numero de la colonne de la case selectionnee
  * 
- * \return true si la valeur est absente sur la ligne, false sinon
+ * \return Numero du bloc, les blocs etant numerotes de gauche a droite et de haut en bas
 */
-bool absentSurLigne(int valeur, tGrille grille, int numLigne) {
-    int i;
-    bool absent = true;
-    i = 0;
-    while (i < TAILLE && absent) {
-        if (grille[numLigne][i] == valeur) {
-            absent = false;
-        }
-        i++;
-    }
-    return absent;
+int numeroBloc(int numLigne, int numColonne) {
+    return (numLigne / n) * n + (numColonne / n);
 }
 
 /**
- * \fn bool absentSurColonne(int valeur, tGrille grille, int numColonne)
- * \brief Verifie si une valeur est absente sur une colonne
- * \param valeur Valeur dont on veut verifier l absence sur la colonne
+ * \fn void initContraintes(tContraintes *contraintes, tGrille grille)
+ * \brief Initialise les masques des valeurs utilisees a partir de la grille
+ * \param contraintes Masques a initialiser
  * \param grille Grille de jeu
- * \param numColonne Numero de la colonne de la case selectionnee
  * 
- * \return true si la valeur est absente sur la colonne, false sinon
+ * Cette fonction parcourt la grille une seule fois et ajoute chaque valeur
+ * deja placee au masque de sa ligne, de sa colonne et de son bloc.
 */
-bool absentSurColonne(int valeur, tGrille grille, int numColonne) {
-    int i;
-    bool absent = true;
-    i = 0;
-    while (i < TAILLE && absent) {
-        if (grille[i][numColonne] == valeur) {
-            absent = false;
+void initContraintes(tContraintes *contraintes, tGrille grille) {
+    int i, j;
+    tMasque bit;
+
+    for (i = 0; i < TAILLE; i++) {
+        contraintes->lignes[i] = 0;
+        contraintes->colonnes[i] = 0;
+        contraintes->blocs[i] = 0;
+    }
+    for (i = 0; i < TAILLE; i++) {
+        for (j = 0; j < TAILLE; j++) {
+            if (grille[i][j] != 0) {
+                bit = 1ULL << (grille[i][j] - 1);
+                contraintes->lignes[i] |= bit;
+                contraintes->colonnes[j] |= bit;
+                contraintes->blocs[numeroBloc(i, j)] |= bit;
+            }
         }
-        i++;
     }
-    return absent;
 }
 
 /**
- * \fn bool absentSurBloc(int valeur, tGrille grille, int numLigne, int numColonne)
- * \brief Verifie si une valeur est absente sur un bloc
- * \param valeur Valeur dont on veut verifier l absence sur le bloc
- * \param grille Grille de jeu
+ * \fn tMasque valeursAutorisees(tContraintes *contraintes, int numLigne, int numColonne)
+ * \brief Determine les valeurs autorisees dans une case
+ * \param contraintes Masques des valeurs utilisees
  * \param numLigne Numero de la ligne de la case selectionnee
  * \param numColonne Numero de la colonne de la case selectionnee
  * 
- * \return true si la valeur est absente sur le bloc, false sinon
+ * \return Masque des valeurs absentes de la ligne, de la colonne et du bloc de la case
 */
-bool absentSurBloc(int valeur, tGrille grille, int numLigne, int numColonne) {
-    int startingRow = numLigne - (numLigne%n);
-    int startingCol = numColonne - (numColonne%n);
+tMasque valeursAutorisees(tContraintes *contraintes, int numLigne, int numColonne) {
+    return ~(contraintes->lignes[numLigne]
+           | contraintes->colonnes[numColonne]
+           | contraintes->blocs[numeroBloc(numLigne, numColonne)]) & TOUTES_VALEURS;
+}
 
-    int i, j;
-    bool absent = true;
-    i = startingRow;
-    while (i < startingRow + n && absent) {
-        j = startingCol;
-        while (j < startingCol + n && absent) {
-            if (grille[i][j] == valeur) {
-                absent = false;
-            }
-            j++;
-        }
-        i++;
-    }
-    return absent;
+/**
+ * \fn void placerValeur(tGrille grille, tContraintes *contraintes, int numLigne, int numColonne, int valeur)
+ * \brief Inscrit une valeur dans une case et met a jour les masques
+ * \param grille Grille de jeu
+ * \param contraintes Masques des valeurs utilisees
+ * \param numLigne Numero de la ligne de la case selectionnee
+ * \param numColonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur a inscrire
+*/
+void placerValeur(tGrille grille, tContraintes *contraintes, int numLigne, int numColonne, int valeur) {
+    tMasque bit = 1ULL << (valeur - 1);
+
+    grille[numLigne][numColonne] = valeur;
+    contraintes->lignes[numLigne] |= bit;
+    contraintes->colonnes[numColonne] |= bit;
+    contraintes->blocs[numeroBloc(numLigne, numColonne)] |= bit;
 }
 
 /**
- * \fn bool backtracking(tGrille grille, int numCase)
+ * \fn void enleverValeur(tGrille grille, tContraintes *contraintes, int numLigne, int numColonne, int valeur)
+ * \brief Vide une case et retire sa valeur des masques
+ * \param grille Grille de jeu
+ * \param contraintes Masques des valeurs utilisees
+ * \param numLigne Numero de la ligne de la case selectionnee
+ * \param numColonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur inscrite dans la case
+*/
+void enleverValeur(tGrille grille, tContraintes *contraintes, int numLigne, int numColonne, int valeur) {
+    tMasque bit = 1ULL << (valeur - 1);
+
+    grille[numLigne][numColonne] = 0;
+    contraintes->lignes[numLigne] &= ~bit;
+    contraintes->colonnes[numColonne] &= ~bit;
+    contraintes->blocs[numeroBloc(numLigne, numColonne)] &= ~bit;
+}
+
+/**
+ * \fn bool backtracking(tGrille grille, tContraintes *contraintes, int numCase)
  * \brief Resout la grille de jeu par backtracking
  * \param grille Grille de jeu
+ * \param contraintes Masques des valeurs utilisees, tenus a jour pendant la recherche
  * \param numCase Numero de la case a traiter
  * 
  * \return true si la grille est resolue, false sinon
  * 
  * Cette fonction resout la grille de jeu par backtracking.
- * Elle verifie si la case est vide, si oui, elle teste toutes les valeurs possibles
- * et si une valeur est autorisee, elle l inscrit dans la case et passe a la case suivante.
+ * Elle verifie si la case est vide, si oui, elle teste les valeurs autorisees
+ * (bits a 1 du masque renvoye par valeursAutorisees) et inscrit chacune d elles
+ * dans la case avant de passer a la case suivante.
  * Si aucune valeur n est autorisee, elle revient en arriere et teste une autre valeur.
  * Si la case n est pas vide, elle passe a la case suivante.
 */
-bool backtracking(tGrille grille, int numCase){
-    int lig, col;
+bool backtracking(tGrille grille, tContraintes *contraintes, int numCase){
+    int lig, col, val;
+    tMasque autorisees;
     bool res = false;
 
     if(numCase == TAILLE*TAILLE){
@@ -179,21 +240,22 @@ bool backtracking(tGrille grille, int numCase){
         if (grille[lig][col] != 0) {
             // La case n'est pas vide, on passe à la suivante
             // (appel récursif)
-            res = backtracking(grille, numCase+1);
+            res = backtracking(grille, contraintes, numCase+1);
         } else {
-            for (int val = 1; val <= TAILLE; val++) {
-                if (absentSurLigne(val, grille, lig) 
-                && absentSurColonne(val, grille, col) 
-                && absentSurBloc(val, grille, lig, col)) {
-                    // Si la valeur est autorisée, on l'inscrit dans la case
-                    grille[lig][col] = val;
-                    // Et on passe à la case suivante : appel récursif
-                    // pour voir si ce choix est bon par la suite
-                    if (backtracking(grille, numCase+1) == true) {
-                        res = true;
-                    } else {
-                        grille[lig][col] = 0;
-                    }
+            autorisees = valeursAutorisees(contraintes, lig, col);
+            while (autorisees != 0 && !res) {
+                // On extrait la plus petite valeur autorisée du masque
+                val = __builtin_ctzll(autorisees) + 1;
+                autorisees &= autorisees - 1;
+
+                // On l'inscrit dans la case
+                placerValeur(grille, contraintes, lig, col, val);
+                // Et on passe à la case suivante : appel récursif
+                // pour voir si ce choix est bon par la suite
+                if (backtracking(grille, contraintes, numCase+1) == true) {
+                    res = true;
+                } else {
+                    enleverValeur(grille, contraintes, lig, col, val);
                 }
             }
         } 
@@ -201,6 +263,91 @@ bool backtracking(tGrille grille, int numCase){
     return res;
 }
 
+/**
+ * \fn int caseMoinsContrainte(tGrille grille, tContraintes *contraintes, tMasque *autorisees)
+ * \brief Determine la case vide ayant le moins de valeurs autorisees
+ * \param grille Grille de jeu
+ * \param contraintes Masques des valeurs utilisees
+ * \param autorisees Masque des valeurs autorisees dans la case choisie (sortie)
+ * 
+ * \return Numero de la case choisie, -1 si la grille ne contient plus de case vide
+ * 
+ * Cette fonction parcourt les cases vides et retient celle qui a le moins
+ * de valeurs autorisees. En cas d egalite, elle retient la case dont la ligne,
+ * la colonne et le bloc contiennent le plus de cases vides, c est-a-dire celle
+ * qui contraint le plus de cases voisines.
+ * Le parcours s arrete des qu une case a zero ou une seule valeur autorisee :
+ * avec zero valeur la branche est un echec, avec une seule le choix est force.
+*/
+int caseMoinsContrainte(tGrille grille, tContraintes *contraintes, tMasque *autorisees) {
+    int i, j, nb, degre;
+    int meilleureCase = -1;
+    int meilleurNb = TAILLE + 1;
+    int meilleurDegre = -1;
+    tMasque masque;
+
+    *autorisees = 0;
+    for (i = 0; i < TAILLE && meilleurNb > 1; i++) {
+        for (j = 0; j < TAILLE && meilleurNb > 1; j++) {
+            if (grille[i][j] == 0) {
+                masque = valeursAutorisees(contraintes, i, j);
+                nb = __builtin_popcountll(masque);
+                // nombre de cases vides dans la ligne, la colonne et le bloc de la case
+                degre = 3*TAILLE - __builtin_popcountll(contraintes->lignes[i])
+                                 - __builtin_popcountll(contraintes->colonnes[j])
+                                 - __builtin_popcountll(contraintes->blocs[numeroBloc(i, j)]);
+                if (nb < meilleurNb || (nb == meilleurNb && degre > meilleurDegre)) {
+                    meilleureCase = i*TAILLE + j;
+                    meilleurNb = nb;
+                    meilleurDegre = degre;
+                    *autorisees = masque;
+                }
+            }
+        }
+    }
+    return meilleureCase;
+}
+
+/**
+ * \fn bool backtrackingMRV(tGrille grille, tContraintes *contraintes)
+ * \brief Resout la grille de jeu par backtracking en choisissant la case la plus contrainte
+ * \param grille Grille de jeu
+ * \param contraintes Masques des valeurs utilisees, tenus a jour pendant la recherche
+ * 
+ * \return true si la grille est resolue, false sinon
+ * 
+ * Cette fonction resout la grille comme backtracking, mais au lieu de
+ * traiter les cases dans l ordre, elle branche a chaque etape sur la case
+ * choisie par caseMoinsContrainte (heuristique MRV, "minimum remaining values").
+ * Si cette case n a aucune valeur autorisee, la branche echoue immediatement.
+*/
+bool backtrackingMRV(tGrille grille, tContraintes *contraintes) {
+    int numCase, lig, col, val;
+    tMasque autorisees;
+    bool res = false;
+
+    numCase = caseMoinsContrainte(grille, contraintes, &autorisees);
+    if (numCase == -1) {
+        // Il n'y a plus de case vide, la grille est résolue
+        res = true;
+    } else {
+        lig = numCase / TAILLE;
+        col = numCase % TAILLE;
+        while (autorisees != 0 && !res) {
+            val = __builtin_ctzll(autorisees) + 1;
+            autorisees &= autorisees - 1;
+
+            placerValeur(grille, contraintes, lig, col, val);
+            if (backtrackingMRV(grille, contraintes) == true) {
+                res = true;
+            } else {
+                enleverValeur(grille, contraintes, lig, col, val);
+            }
+        }
+    }
+    return res;
+}
+
 /**
  * \fn int premiereCaseVide(tGrille grille)
  * \brief Determine la premiere case vide de la grille
@@ -4,752 +4,2881 @@
  * \author PFRANGER Matheo, FAUCHET Malo
  * \date 28 Janvier 2024
  * \version 1.0
+ * 
+ * La taille de bloc n est lue dans le fichier de la grille (ou donnee par l option -n),
+ * et la grille est resolue par le noyau de noyau.h specialise pour cette taille.
+ * Compilation : gcc -O2 -pthread -o RESOLUTION-2 RESOLUTION-2.c
+ * (avec -DINSTRUMENTATION pour les compteurs de --compteurs)
 */
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <limits.h>
 #include <time.h>
 #include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+
+#include "parallele.h"
+
+/**
+ * \def N_MIN
+ * \brief Plus petite taille de bloc geree
+*/
+#define N_MIN 2
+
+/**
+ * \def N_MAX
+ * \brief Plus grande taille de bloc geree (grille 64x64, un masque de 64 bits par case)
+*/
+#define N_MAX 8
+
+/**
+ * \def TAILLE_VECTEUR
+ * \brief Taille en octets des vecteurs de masques des noyaux (tVecteur de noyau.h)
+ *
+ * 32 avec AVX2 (-mavx2 ou -march=native), 16 avec SSE2 ou NEON. Sans jeu d instructions
+ * vectoriel, le compilateur calcule les vecteurs de 8 octets avec les instructions
+ * ordinaires ; -DTAILLE_VECTEUR=8 impose ce cas partout.
+*/
+#ifndef TAILLE_VECTEUR
+#if defined(__AVX2__)
+#define TAILLE_VECTEUR 32
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+#define TAILLE_VECTEUR 16
+#else
+#define TAILLE_VECTEUR 8
+#endif
+#endif
+
+/**
+ * \typedef tTranche
+ * \brief Un bit par grille d un paquet (--paquets) : bit g a 1 si la propriete est vraie dans la grille g
+*/
+typedef unsigned long long tTranche __attribute__((vector_size(TAILLE_VECTEUR)));
+
+/**
+ * \def TAILLE_PAQUET
+ * \brief Nombre de grilles resolues ensemble par un noyau de paquet, une par bit de tTranche
+*/
+#define TAILLE_PAQUET (8 * TAILLE_VECTEUR)
+
+
+/**
+ * \enum tMoteur
+ * \brief Moteur de recherche utilise apres les singletons
+*/
+typedef enum {
+    MOTEUR_LIGNE,       // backtracking recursif, cases dans l ordre
+    MOTEUR_MRV,         // backtracking recursif, case la plus contrainte d abord
+    MOTEUR_ITERATIF,    // recherche iterative avec piste d annulation
+    MOTEUR_MAC          // recherche iterative avec propagation des singletons
+} tMoteur;
+
+/**
+ * \def NB_MOTEURS
+ * \brief Nombre de moteurs de recherche
+*/
+#define NB_MOTEURS 4
+
+/**
+ * \var NOMS_MOTEURS
+ * \brief Nom de chaque moteur, tel qu il est donne a --strategies et affiche par --course
+*/
+const char *NOMS_MOTEURS[NB_MOTEURS] = {"ligne", "mrv", "iteratif", "mac"};
+
+/**
+ * \enum tEtage
+ * \brief Etage de propagation applique quand il n y a plus de singleton, un bit chacun
+ *
+ * Les sous-ensembles nus et caches de taille 2 a 4 sont sur des bits consecutifs :
+ * ETAGE_PAIRES << (taille - 2) et ETAGE_PAIRES_CACHEES << (taille - 2).
+ * Les poissons et le coloriage forment le palier couteux, essaye seulement quand
+ * les autres etages ne retirent plus rien.
+*/
+typedef enum {
+    ETAGE_BLOQUES = 1,                  // candidats pointants et reduction bloc-ligne
+    ETAGE_PAIRES = 2,                   // paires nues
+    ETAGE_TRIPLETS = 4,                 // triplets nus
+    ETAGE_QUADRUPLETS = 8,              // quadruplets nus
+    ETAGE_PAIRES_CACHEES = 16,          // paires cachees
+    ETAGE_TRIPLETS_CACHES = 32,         // triplets caches
+    ETAGE_QUADRUPLETS_CACHES = 64,      // quadruplets caches
+    ETAGE_POISSONS = 128,               // X-Wing, Swordfish, Jellyfish... (palier couteux)
+    ETAGE_COLORIAGE = 256               // coloriage simple des paires conjuguees (palier couteux)
+} tEtage;
+
+/**
+ * \def NB_ETAGES
+ * \brief Nombre d etages de propagation
+*/
+#define NB_ETAGES 9
+
+/**
+ * \var NOMS_ETAGES
+ * \brief Nom de chaque etage, dans l ordre des bits, tel qu il est donne a --etages et a --strategies
+*/
+const char *NOMS_ETAGES[NB_ETAGES] = {
+    "bloques", "paires", "triplets", "quadruplets", "paires-cachees", "triplets-caches", "quadruplets-caches",
+    "poissons", "coloriage"
+};
+
+/**
+ * \def ESSAIS_PALIER
+ * \brief Nombre d essais du palier couteux avant de juger s il rapporte
+ *
+ * Apres ESSAIS_PALIER essais pour une grille, le palier est abandonne pour le reste
+ * de sa resolution si moins d un essai sur ESSAIS_PALIER a retire un candidat. La
+ * regle compte des essais plutot que du temps, pour que le nombre de noeuds d une
+ * grille ne depende pas de la machine.
+*/
+#define ESSAIS_PALIER 16
+
+/**
+ * \enum tClasse
+ * \brief Classe d une unite de contrainte : une case est dans au plus une unite de chaque classe
+*/
+typedef enum {
+    CLASSE_LIGNE,
+    CLASSE_COLONNE,
+    CLASSE_REGION,              // bloc n x n, ou region irreguliere de --regions
+    CLASSE_DIAGONALE,           // diagonale principale (--variante x)
+    CLASSE_ANTIDIAGONALE,       // diagonale secondaire (--variante x)
+    CLASSE_FENETRE              // bloc decale d une case (--variante fenetres)
+} tClasse;
+
+/**
+ * \def NB_CLASSES
+ * \brief Nombre de classes d unites
+*/
+#define NB_CLASSES 6
+
+/**
+ * \struct tVariante
+ * \brief Unites de contrainte ajoutees ou remplacees par rapport a la grille classique
+ *
+ * La variante est commune a tout le lot : elle est fixee par la ligne de commande
+ * avant toute resolution, puis lue une fois par noyau (initTopologie de noyau.h).
+ * Les regions de --regions ne valent que pour les grilles de leur taille de bloc,
+ * les autres gardent leurs blocs n x n.
+*/
+typedef struct {
+    bool diagonales;            // les deux grandes diagonales sont des unites (sudoku X)
+    bool fenetres;              // les (n-1)^2 blocs dont le coin est en (1+k(n+1), 1+l(n+1)) (windoku)
+    int tailleRegions;          // taille de bloc des regions, 0 sans --regions
+    unsigned char *regions;     // region (0 a TAILLE-1) de chaque case, ligne par ligne
+} tVariante;
+
+/**
+ * \var variante
+ * \brief Variante des grilles du lot, classique par defaut
+*/
+tVariante variante = {false, false, 0, NULL};
+
+/**
+ * \struct tPartage
+ * \brief Etat partage par les threads qui resolvent ensemble une meme grille (--decouper)
+ * 
+ * Chaque tache du pool est une grille : la grille a resoudre, ou une branche de sa
+ * recherche donnee par un thread a un thread inactif. La premiere solution trouvee
+ * arrete tous les threads.
+*/
+typedef struct {
+    int tailleBloc;
+    tMoteur moteur;             // MOTEUR_ITERATIF ou MOTEUR_MAC
+    bool balayage;
+    unsigned etages;
+    int profondeurMax;          // seuls les choix moins profonds donnent leurs branches
+    atomic_bool arret;          // la grille est resolue
+    int *solution;              // cases de la solution, ecrites par le thread qui l a trouvee
+    int **taches;               // cases de chaque tache, liberees une fois la tache traitee
+    int nbTaches;
+    int capacite;
+    pthread_mutex_t verrou;     // protege taches, nbTaches et capacite
+    void *(*travaux)[N_MAX + 1];  // etat de resolution de chaque thread, par taille de bloc
+} tPartage;
+
+/**
+ * \struct tDonneur
+ * \brief Thread qui participe avec d autres a la resolution d une meme grille
+*/
+typedef struct {
+    tPool *pool;
+    int numTravailleur;
+    atomic_bool *arret;         // passe a true quand un thread a repondu, les autres s arretent
+    int profondeurMax;          // profondeur des choix dont les branches sont donnees, 0 : aucune
+    tPartage *partage;          // destinataire des branches donnees (donnerTache)
+} tDonneur;
+
+bool donnerTache(tDonneur *donneur, int *cases);
+
+/**
+ * \typedef tResolution
+ * \brief Point d entree d un noyau : resout une grille dont les cases sont donnees ligne par ligne
+*/
+typedef bool (*tResolution)(int *cases, tMoteur moteur, bool balayage, unsigned etages, void **travail, tDonneur *donneur);
+
+/**
+ * \typedef tComptage
+ * \brief Point d entree d un noyau : compte les solutions d une grille, jusqu a une limite
+*/
+typedef long (*tComptage)(int *cases, tMoteur moteur, bool balayage, unsigned etages, long limite, void **travail);
+
+/**
+ * \typedef tRappelSolution
+ * \brief Fonction qui recoit chaque solution enumeree, cases ligne par ligne :
+ * elle rend false pour arreter l enumeration
+*/
+typedef bool (*tRappelSolution)(const unsigned char *valeurs, void *contexte);
+
+/**
+ * \typedef tEnumeration
+ * \brief Point d entree d un noyau : passe les solutions d une grille une a une a un rappel
+*/
+typedef long (*tEnumeration)(int *cases, tMoteur moteur, bool balayage, unsigned etages, long limite,
+                             tRappelSolution rappel, void *contexte, void **travail);
+
+/**
+ * \typedef tDenombrement
+ * \brief Point d entree d un noyau : compte les solutions d une grille sans les construire
+*/
+typedef long (*tDenombrement)(int *cases, bool balayage, unsigned etages, long limite, void **travail);
+
+/**
+ * \enum tEtatPaquet
+ * \brief Etat d une grille a la fin de la reduction de son paquet
+*/
+typedef enum {
+    PAQUET_A_CHERCHER,      // les singletons ne suffisent pas : la recherche reprend la grille reduite
+    PAQUET_RESOLUE,         // les singletons ont rempli toute la grille
+    PAQUET_SANS_SOLUTION    // les singletons ont trouve une contradiction
+} tEtatPaquet;
+
+/**
+ * \typedef tReduction
+ * \brief Point d entree d un noyau : place les singletons de plusieurs grilles a la fois
+*/
+typedef void (*tReduction)(int **grilles, int nbGrilles, tEtatPaquet *etats, void **travail);
+
+/**
+ * \typedef tNoeuds
+ * \brief Point d entree d un noyau : nombre de noeuds de la derniere recherche d un etat de resolution
+*/
+typedef long (*tNoeuds)(void *travail);
+
+/**
+ * \def COMPTER
+ * \brief Instruction d instrumentation de la recherche, compilee seulement avec -DINSTRUMENTATION
+ *
+ * Sans INSTRUMENTATION, l instruction disparait du noyau : les compteurs n ajoutent
+ * alors ni calcul ni memoire a la resolution.
+*/
+#ifdef INSTRUMENTATION
+#define COMPTER(...) __VA_ARGS__
+#else
+#define COMPTER(...)
+#endif
+
+/**
+ * \enum tTechnique
+ * \brief Technique a qui sont attribues les candidats elimines et les cases remplies
+*/
+typedef enum {
+    TECHNIQUE_SINGLETON_NU,         // checkSingletonNu (balayage)
+    TECHNIQUE_CACHEE_LIGNE,         // checkSingletonCacheeLigne (balayage)
+    TECHNIQUE_CACHEE_COLONNE,       // checkSingletonCacheeColonne (balayage)
+    TECHNIQUE_CACHEE_REGION,        // checkSingletonCacheeRegion (balayage)
+    TECHNIQUE_PROPAGATION_NU,       // singleton nu de propagerSingletons (file de travail)
+    TECHNIQUE_PROPAGATION_CACHEE,   // singleton cache de propagerSingletons (file de travail)
+    TECHNIQUE_BLOQUES,              // candidats bloques (etage, sans placement)
+    TECHNIQUE_SOUS_ENSEMBLE_NU,     // paires, triplets et quadruplets nus (etages, sans placement)
+    TECHNIQUE_SOUS_ENSEMBLE_CACHE,  // paires, triplets et quadruplets caches (etages, sans placement)
+    TECHNIQUE_POISSON,              // poissons de 2 lignes ou colonnes et plus (palier, sans placement)
+    TECHNIQUE_COLORIAGE,            // coloriage simple (palier, sans placement)
+    TECHNIQUE_CHOIX                 // valeur essayee par la recherche
+} tTechnique;
+
+/**
+ * \def NB_TECHNIQUES
+ * \brief Nombre de techniques distinguees par les compteurs
+*/
+#define NB_TECHNIQUES 12
+
+/**
+ * \var NOMS_TECHNIQUES
+ * \brief Nom de chaque technique dans le JSON de --compteurs
+*/
+const char *NOMS_TECHNIQUES[NB_TECHNIQUES] = {
+    "singleton_nu", "cachee_ligne", "cachee_colonne", "cachee_region", "propagation_nu", "propagation_cachee",
+    "bloques", "sous_ensemble_nu", "sous_ensemble_cache", "poisson", "coloriage", "choix"
+};
+
+/**
+ * \struct tCompteurs
+ * \brief Compteurs de la derniere resolution d un noyau compile avec -DINSTRUMENTATION
+ *
+ * Les eliminations et les placements faits pendant la recherche sont comptes meme
+ * s ils sont ensuite annules par un retour en arriere.
+*/
+typedef struct {
+    long retours;                       // valeurs essayees qui ont mene a une impasse
+    int profondeur;                     // choix en cours (moteurs recursifs)
+    int profondeurMax;                  // plus grand nombre de choix en cours
+    tTechnique technique;               // technique en cours
+    long eliminations[NB_TECHNIQUES];   // candidats retires par chaque technique
+    long placements[NB_TECHNIQUES];     // valeurs inscrites par chaque technique
+    int casesVides;                     // cases vides de la grille donnee
+    int casesLogique;                   // cases remplies par les singletons avant la recherche
+    double tempsLogique;                // secondes passees a placer les singletons avant la recherche
+    double tempsRecherche;              // secondes passees dans la recherche
+    double tempsPropagation;            // secondes de la recherche passees a propager les singletons
+    double tempsEtages;                 // secondes passees dans les etages, avant et pendant la recherche
+    int essaisPalier;                   // appels du palier couteux
+    int succesPalier;                   // appels du palier couteux qui ont retire un candidat
+    double tempsPalier;                 // secondes passees dans le palier couteux (comprises dans tempsEtages)
+} tCompteurs;
+
+#ifdef INSTRUMENTATION
+/**
+ * \typedef tLectureCompteurs
+ * \brief Point d entree d un noyau instrumente : compteurs de la derniere resolution d un etat de resolution
+*/
+typedef const tCompteurs *(*tLectureCompteurs)(void *travail);
+
+/**
+ * \fn void entrerChoix(tCompteurs *compteurs)
+ * \brief Compte une valeur essayee par un moteur recursif et la profondeur qu elle atteint
+ * \param compteurs Compteurs de la resolution, dont la profondeur est decrementee au retour du choix
+*/
+static inline void entrerChoix(tCompteurs *compteurs) {
+    compteurs->placements[TECHNIQUE_CHOIX]++;
+    compteurs->profondeur++;
+    if (compteurs->profondeur > compteurs->profondeurMax) {
+        compteurs->profondeurMax = compteurs->profondeur;
+    }
+}
+#endif
+
+#include "trace.h"
+
+double tempsEcoule(void);
+
+/**
+ * \fn bool trancheVide(tTranche tranche)
+ * \brief Indique si une tranche n a aucun bit a 1
+ * \param tranche Tranche a tester
+ *
+ * \return true si la propriete n est vraie dans aucune grille du paquet
+*/
+static inline bool trancheVide(tTranche tranche) {
+    unsigned long long ou = 0;
+
+    for (int i = 0; i < (int) (sizeof(tTranche) / sizeof(unsigned long long)); i++) {
+        ou |= tranche[i];
+    }
+    return ou == 0;
+}
+
+/**
+ * \fn bool bitTranche(tTranche tranche, int numGrille)
+ * \brief Lit le bit d une grille dans une tranche
+ * \param tranche Tranche a lire
+ * \param numGrille Rang de la grille dans le paquet
+ *
+ * \return true si la propriete est vraie dans la grille
+*/
+static inline bool bitTranche(tTranche tranche, int numGrille) {
+    return (tranche[numGrille / 64] >> (numGrille % 64)) & 1;
+}
+
+
+/*****************************************************
+ *                       NOYAUX                      *
+ *****************************************************/
+
+#define n 2
+#include "noyau.h"
+#define n 3
+#include "noyau.h"
+#define n 4
+#include "noyau.h"
+#define n 5
+#include "noyau.h"
+#define n 6
+#include "noyau.h"
+#define n 7
+#include "noyau.h"
+#define n 8
+#include "noyau.h"
+
+/**
+ * \var RESOLUTIONS
+ * \brief Noyau a utiliser pour chaque taille de bloc, indice par la taille de bloc
+*/
+const tResolution RESOLUTIONS[N_MAX + 1] = {
+    NULL, NULL, resoudre_2, resoudre_3, resoudre_4, resoudre_5, resoudre_6, resoudre_7, resoudre_8
+};
+
+/**
+ * \var COMPTAGES
+ * \brief Comptage des solutions de chaque noyau, indice par la taille de bloc
+*/
+const tComptage COMPTAGES[N_MAX + 1] = {
+    NULL, NULL, compterSolutions_2, compterSolutions_3, compterSolutions_4, compterSolutions_5,
+    compterSolutions_6, compterSolutions_7, compterSolutions_8
+};
+
+/**
+ * \var ENUMERATIONS
+ * \brief Enumeration des solutions de chaque noyau, indice par la taille de bloc
+*/
+const tEnumeration ENUMERATIONS[N_MAX + 1] = {
+    NULL, NULL, enumererSolutions_2, enumererSolutions_3, enumererSolutions_4, enumererSolutions_5,
+    enumererSolutions_6, enumererSolutions_7, enumererSolutions_8
+};
+
+/**
+ * \var DENOMBREMENTS
+ * \brief Denombrement des solutions de chaque noyau, indice par la taille de bloc
+*/
+const tDenombrement DENOMBREMENTS[N_MAX + 1] = {
+    NULL, NULL, denombrerSolutions_2, denombrerSolutions_3, denombrerSolutions_4, denombrerSolutions_5,
+    denombrerSolutions_6, denombrerSolutions_7, denombrerSolutions_8
+};
+
+/**
+ * \var REDUCTIONS
+ * \brief Reduction d un paquet de grilles par chaque noyau, indice par la taille de bloc
+*/
+const tReduction REDUCTIONS[N_MAX + 1] = {
+    NULL, NULL, reduirePaquet_2, reduirePaquet_3, reduirePaquet_4, reduirePaquet_5,
+    reduirePaquet_6, reduirePaquet_7, reduirePaquet_8
+};
+
+/**
+ * \var NOEUDS
+ * \brief Nombre de noeuds explores par chaque noyau, indice par la taille de bloc
+*/
+const tNoeuds NOEUDS[N_MAX + 1] = {
+    NULL, NULL, noeudsExplores_2, noeudsExplores_3, noeudsExplores_4, noeudsExplores_5,
+    noeudsExplores_6, noeudsExplores_7, noeudsExplores_8
+};
+
+#ifdef INSTRUMENTATION
+/**
+ * \var COMPTEURS
+ * \brief Compteurs de la derniere resolution de chaque noyau, indice par la taille de bloc
+*/
+const tLectureCompteurs COMPTEURS[N_MAX + 1] = {
+    NULL, NULL, lireCompteurs_2, lireCompteurs_3, lireCompteurs_4, lireCompteurs_5,
+    lireCompteurs_6, lireCompteurs_7, lireCompteurs_8
+};
+#endif
+
+
+/**
+ * \def CELLULE_VIDE
+ * \brief Caractere representant une cellule vide
+*/
+const char CELLULE_VIDE = '.' ;
+
+#include "corpus.h"
+#include "texte.h"
+
+/**
+ * \def NB_STRATEGIES_MAX
+ * \brief Nombre maximum de strategies en concurrence (chaque moteur avec ou sans balayage,
+ * ou un meme moteur avec differents etages)
+*/
+#define NB_STRATEGIES_MAX (4*NB_MOTEURS)
+
+/**
+ * \def TAILLE_NOM_STRATEGIE
+ * \brief Longueur maximale du nom d une strategie, balayage et etages compris
+*/
+#define TAILLE_NOM_STRATEGIE 160
+
+/**
+ * \struct tStrategie
+ * \brief Strategie de resolution mise en concurrence par --course
+*/
+typedef struct {
+    tMoteur moteur;
+    bool balayage;
+    unsigned etages;    // drapeaux tEtage
+} tStrategie;
+
+/**
+ * \struct tOptions
+ * \brief Options de la ligne de commande
+*/
+typedef struct {
+    tMoteur moteur;     // moteur de recherche
+    bool balayage;      // singletons par balayage au lieu de la file de travail
+    int tailleBloc;     // taille de bloc imposee par -n, 0 si elle est deduite du fichier
+    bool silencieux;    // en mode lot, n affiche pas les grilles resolues
+    int nbTravailleurs; // nombre de threads
+    bool epingler;      // fixe chaque thread sur un coeur
+    bool decouper;      // les threads se partagent la recherche de chaque grille
+    int profondeurMax;  // avec decouper, profondeur des choix dont les branches sont partagees
+    bool course;        // les strategies resolvent chaque grille en concurrence, une par thread
+    tStrategie strategies[NB_STRATEGIES_MAX];
+    int nbStrategies;
+    bool unicite;       // verifie que chaque grille a une seule solution
+    bool toutes;        // ecrit toutes les solutions de chaque grille, au fil de la recherche
+    bool compter;       // compte les solutions de chaque grille sans les ecrire
+    long maxSolutions;  // avec toutes ou compter, nombre de solutions apres lequel on s arrete
+    bool banc;          // mesure chaque strategie sur chaque grille au lieu de resoudre le lot
+    int echauffement;   // avec banc, executions non mesurees avant les mesures
+    int repetitions;    // avec banc, executions mesurees par grille et par strategie
+    const char *nomReference;   // avec banc, mesures precedentes a comparer, ou NULL
+    double seuil;       // avec banc, ralentissement signale, en pourcentage de la mediane de reference
+    FILE *compteurs;    // avec --compteurs, fichier ou ecrire les compteurs de chaque grille, NULL sinon
+    FILE *trace;        // avec --trace, fichier ou noter les evenements de la recherche, NULL sinon
+    bool paquets;       // les singletons sont places par paquets de TAILLE_PAQUET grilles
+    unsigned etages;    // drapeaux tEtage des etages de propagation
+} tOptions;
+
+/**
+ * \struct tBilan
+ * \brief Nombre de grilles traitees en mode lot, par resultat
+*/
+typedef struct {
+    int resolues;       // avec --unicite, grilles a solution unique
+    int multiples;      // avec --unicite, grilles a plusieurs solutions
+    int sansSolution;
+    int erreurs;        // fichiers illisibles ou grilles invalides
+    long solutions;     // avec --toutes ou --compter, solutions de toutes les grilles
+} tBilan;
+
+/**
+ * \enum tCodeSortie
+ * \brief Codes de sortie du programme
+ * 
+ * En mode lot, les erreurs de lecture l emportent sur les grilles sans solution,
+ * qui l emportent sur les grilles a plusieurs solutions.
+*/
+typedef enum {
+    SORTIE_OK = EXIT_SUCCESS,   // toutes les grilles sont resolues
+    SORTIE_USAGE = EXIT_FAILURE,// ligne de commande invalide
+    SORTIE_ERREUR_LECTURE = 2,  // au moins un fichier ou une grille n a pas pu etre lu
+    SORTIE_SANS_SOLUTION = 3,   // au moins une grille n a pas de solution
+    SORTIE_MULTIPLE = 4,        // avec --unicite, au moins une grille a plusieurs solutions
+    SORTIE_RALENTI = 5          // avec --banc, au moins une mesure plus lente que la reference
+} tCodeSortie;
+
+/**
+ * \enum tResultat
+ * \brief Resultat de la resolution d une grille du mode lot
+*/
+typedef enum {
+    RESULTAT_A_RESOUDRE,
+    RESULTAT_RESOLUE,
+    RESULTAT_SANS_SOLUTION,
+    RESULTAT_INVALIDE,          // une case est hors de [0, TAILLE]
+    RESULTAT_UNIQUE,            // avec --unicite, resolue et sans autre solution
+    RESULTAT_MULTIPLE,          // avec --unicite, au moins deux solutions
+    RESULTAT_SOLUTIONS          // avec --toutes ou --compter, au moins une solution
+} tResultat;
+
+/**
+ * \var NOMS_RESULTATS
+ * \brief Nom de chaque resultat, tel qu il est ecrit en mode lot
+*/
+const char *NOMS_RESULTATS[] = {"a_resoudre", "resolue", "sans_solution", "invalide", "unique", "multiple", "solutions"};
+
+/**
+ * \struct tGrilleLot
+ * \brief Grille du mode lot, avec son resultat
+*/
+typedef struct {
+    int *cases;         // cases ligne par ligne, dans le contenu du fichier, remplacees par la solution
+    const unsigned char *compacte;  // cases compactees dans un corpus projete en memoire ou lues dans
+                                    // un texte, NULL sinon : cases vaut alors NULL tant que la grille
+                                    // n est pas decompactee
+    int bitsCompacte;   // nombre de bits par case de compacte
+    int tailleBloc;
+    int numFichier;     // rang du fichier dans le lot
+    int indice;         // rang de la grille dans le fichier, a partir de 1
+    tResultat resultat;
+    double temps;       // temps CPU de la resolution (temps reel a plusieurs threads), en secondes
+    int gagnante;       // avec --course, rang de la strategie qui a repondu, -1 sinon
+    long nbSolutions;   // avec --toutes ou --compter, nombre de solutions (au plus --max-solutions)
+#ifdef INSTRUMENTATION
+    long nbNoeuds;          // noeuds de la recherche, pour --compteurs
+    tCompteurs compteurs;   // compteurs de la resolution, pour --compteurs
+#endif
+} tGrilleLot;
+
+/**
+ * \struct tFichierLot
+ * \brief Fichier lu en mode lot
+*/
+typedef struct {
+    char *nom;
+    void *contenu;      // entiers d un fichier .sud ou cases d un texte, ou NULL
+    void *projection;   // corpus projete en memoire, ou NULL
+    size_t tailleProjection;
+} tFichierLot;
+
+/**
+ * \struct tLot
+ * \brief Toutes les grilles a resoudre en mode lot, dans l ordre des arguments
+ * 
+ * Les grilles sont toutes chargees avant d etre resolues, puis les resultats sont
+ * ecrits dans cet ordre, quel que soit l ordre dans lequel les threads les terminent.
+*/
+typedef struct {
+    tGrilleLot *grilles;
+    int nbGrilles;
+    tFichierLot *fichiers;
+    int nbFichiers;
+    int erreurs;        // fichiers illisibles
+} tLot;
+
+/**
+ * \struct tContexteLot
+ * \brief Donnees partagees par les threads qui resolvent un lot
+*/
+typedef struct {
+    tLot *lot;
+    tOptions *options;
+    void *(*travaux)[N_MAX + 1];  // etat de resolution de chaque thread, par taille de bloc
+    tTrace *traces;     // avec --trace, tampon de chaque thread, NULL sinon
+    void *(*paquets)[N_MAX + 1];  // avec --paquets, etat de reduction de chaque thread, par taille de bloc
+} tContexteLot;
+
+/**
+ * \struct tCourse
+ * \brief Etat partage par les strategies qui resolvent une meme grille en concurrence
+*/
+typedef struct {
+    int tailleBloc;
+    int *grille;                // grille a resoudre, lue par toutes les strategies
+    int *solution;              // solution, ecrite par la strategie gagnante
+    tOptions *options;          // strategies en concurrence
+    atomic_bool arret;          // une strategie a repondu
+    int gagnante;               // rang de la strategie qui a repondu
+    bool resolue;               // reponse de la strategie gagnante
+    void *(*travaux)[N_MAX + 1];
+} tCourse;
+
+/**
+ * \struct tSortieSolutions
+ * \brief Destination des solutions enumerees par --toutes
+*/
+typedef struct {
+    FILE *sortie;
+    int tailleBloc;
+    bool enGrille;      // chaque solution est affichee en grille (mode interactif), sinon sur une ligne
+    int *cases;         // avec enGrille, cases de la solution a afficher
+    long nb;            // solutions recues
+} tSortieSolutions;
+
+/**
+ * \struct tReference
+ * \brief Mesure d une execution precedente du banc d essai, lue par --reference
+*/
+typedef struct {
+    char *cle;          // grille et strategie, telles qu ecrites dans la ligne JSON, separees par une tabulation
+    double mediane;     // en secondes
+} tReference;
+
+// Misc functions
+int *chargerGrille(int *tailleBloc);
+int tailleBlocDepuisNbCases(long nbCases);
+char *lireFlux(FILE *f, size_t *nbOctets);
+bool grilleValide(int *grille, int tailleBloc);
+double tempsCPU(void);
+int ajouterFichier(tLot *lot, const char *nom, void *contenu);
+tGrilleLot *ajouterGrilles(tLot *lot, long nbGrilles, int numFichier, int tailleBloc);
+void chargerTexte(const char *donnees, size_t taille, const char *nom, tOptions *options, tLot *lot);
+void chargerFlux(FILE *f, const char *nom, tOptions *options, tLot *lot);
+void chargerChemin(const char *chemin, tOptions *options, tLot *lot);
+int comparerNoms(const void *a, const void *b);
+void chargerDossier(const char *chemin, tOptions *options, tLot *lot);
+void chargerCorpus(const char *chemin, tOptions *options, tLot *lot);
+bool preparerCases(tGrilleLot *grille);
+void relacherCases(tGrilleLot *grille, tOptions *options);
+bool convertirLot(tLot *lot, const char *nomCorpus);
+void resoudreTache(tPool *pool, int numTravailleur, int tache);
+void resoudrePaquet(tPool *pool, int numTravailleur, int tache);
+void resoudreSousArbre(tPool *pool, int numTravailleur, int tache);
+bool resoudreDecoupe(int *grille, int tailleBloc, tOptions *options, void *(*travaux)[N_MAX + 1]);
+bool lireEtages(const char *liste, unsigned *etages);
+bool lireStrategies(const char *liste, tOptions *options);
+bool lireVariante(const char *liste, tVariante *variante);
+bool chargerRegions(const char *nom, tVariante *variante);
+void nommerStrategie(const tStrategie *strategie, char *nom, size_t taille);
+void courirStrategie(tPool *pool, int numTravailleur, int tache);
+bool resoudreCourse(int *grille, int tailleBloc, tOptions *options, void *(*travaux)[N_MAX + 1], int *gagnante);
+void resoudreEnsemble(tGrilleLot *grille, tOptions *options, void *(*travaux)[N_MAX + 1]);
+void resoudreLot(tLot *lot, tOptions *options);
+void ecrireResultat(tLot *lot, tGrilleLot *grille, tOptions *options, FILE *sortie, tBilan *bilan);
+#ifdef INSTRUMENTATION
+void noterCompteurs(tGrilleLot *grille, void *travail);
+void ecrireCompteurs(tLot *lot, tGrilleLot *grille, tOptions *options);
+#endif
+void ecrireLot(tLot *lot, tOptions *options, FILE *sortie, tBilan *bilan);
+bool ecrireSolution(const unsigned char *valeurs, void *contexte);
+void enumererLot(tLot *lot, tOptions *options, FILE *sortie, tBilan *bilan);
+tTrace *creerTraces(FILE *f, pthread_mutex_t *verrou, int nb);
+void libererTraces(tTrace *traces, int nb);
+int analyserFichierTrace(const char *nomTrace, const char *nomSortie, const char *nomPiles);
+void libererLot(tLot *lot);
+void usage(const char *programme);
+int nombreChiffre(int nombre);
+void echapperJson(const char *texte, char *dest, size_t taille);
+int comparerDurees(const void *a, const void *b);
+double quantile(const double *durees, int nb, double q);
+long memoireMaximale(void);
+bool lireChampJson(const char *ligne, const char *champ, char *dest, size_t taille);
+tReference *lireReference(const char *nom, int *nbReferences);
+int mesurerLot(tLot *lot, tOptions *options, FILE *sortie);
+void afficherEspaces(FILE *sortie, int nombre_espaces);
+void afficherLigneSeparatrice(FILE *sortie, int nombre_espaces, int tailleBloc);
+void afficherGrille(FILE *sortie, int *grille, int tailleBloc);
+
+/*****************************************************
+ *                PROGRAMME PRINCIPAL                *
+ *****************************************************/
+
+int main(int argc, char *argv[]) {
+    int *grille;
+    tOptions options = {MOTEUR_LIGNE, false, 0, false, 1, false, false, 8, false, {{0}}, 0, false, false, false, LONG_MAX,
+                        false, 1, 10, NULL, 10.0, NULL, NULL, false, 0};
+    tBilan bilan = {0, 0, 0, 0, 0};
+    tLot lot = {NULL, 0, NULL, 0, 0};
+    FILE *sortie = stdout;
+    const char *nomSortie = NULL;
+    const char *nomCorpus = NULL;
+    const char *nomCompteurs = NULL;
+    const char *nomTrace = NULL;
+    const char *nomAnalyse = NULL;
+    const char *nomPiles = NULL;
+    int nbChemins = 0;
+    bool resolue;
+
+    // moteur de recherche utilise apres les singletons :
+    // - par defaut, backtracking recursif ligne par ligne
+    // - --mrv : backtracking recursif sur la case la plus contrainte (MRV)
+    // - --iteratif : recherche iterative MRV avec pile de choix et piste d annulation
+    // - --mac : recherche iterative avec propagation des singletons apres chaque choix
+    // les singletons sont cherches avant la recherche par propagation (file de travail),
+    // ou par balayage complet de la grille avec --balayage
+    // -n impose la taille de bloc au lieu de la deduire de la taille du fichier
+    // les autres arguments sont des fichiers .sud, des dossiers ou - (entree standard),
+    // resolus a la suite (mode lot) ; sans eux, la grille est choisie au clavier
+    // -j repartit le mode lot sur plusieurs threads (0 : un par coeur)
+    // --decouper fait resoudre chaque grille par tous les threads a la fois,
+    // qui se donnent les branches des --profondeur premiers choix de la recherche iterative
+    // --course fait resoudre chaque grille par plusieurs strategies en concurrence
+    // (--strategies, par defaut ligne,mrv,iteratif,mac) : la premiere qui repond gagne
+    // --convertir ecrit les grilles du lot dans un corpus compact au lieu de les resoudre
+    // --unicite cherche une deuxieme solution apres la premiere, avec la recherche iterative
+    // --toutes ecrit toutes les solutions au fil de la recherche, --compter les compte sans
+    // les construire, l un et l autre jusqu a --max-solutions
+    // --banc mesure chaque strategie de --strategies sur chaque grille (le dossier grilles/
+    // par defaut) et ecrit une ligne JSON par mesure, comparee a --reference s il est donne
+    // --compteurs ecrit les compteurs de la resolution de chaque grille (compilation avec
+    // -DINSTRUMENTATION)
+    // --etages ajoute a la propagation des singletons des etages qui retirent d autres
+    // candidats (candidats bloques, sous-ensembles nus et caches), puis le palier couteux
+    // (poissons, coloriage) quand ils ne retirent plus rien et tant qu il rapporte
+    // --paquets place les singletons de TAILLE_PAQUET grilles a la fois avant de chercher
+    // une par une celles qui ne sont pas resolues
+    // --variante ajoute des unites a toutes les grilles (x : les deux diagonales, fenetres :
+    // les blocs du windoku), --regions remplace les blocs par les regions lues dans un fichier
+    // pour les grilles de sa taille ; tous les moteurs et etages s appliquent aux variantes
+    // --trace note les choix, les retours et les singletons de la recherche dans un fichier
+    // binaire, que --analyser resume (et ecrit en piles repliees dans --piles) sans rien resoudre
+    lireStrategies("ligne,mrv,iteratif,mac", &options);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--mrv") == 0) {
+            options.moteur = MOTEUR_MRV;
+        } else if (strcmp(argv[i], "--iteratif") == 0) {
+            options.moteur = MOTEUR_ITERATIF;
+        } else if (strcmp(argv[i], "--mac") == 0) {
+            options.moteur = MOTEUR_MAC;
+        } else if (strcmp(argv[i], "--balayage") == 0) {
+            options.balayage = true;
+        } else if (strcmp(argv[i], "--silencieux") == 0) {
+            options.silencieux = true;
+        } else if (strcmp(argv[i], "--epingler") == 0) {
+            options.epingler = true;
+        } else if (strcmp(argv[i], "--decouper") == 0) {
+            options.decouper = true;
+        } else if (strcmp(argv[i], "--profondeur") == 0 && i+1 < argc) {
+            i++;
+            options.profondeurMax = atoi(argv[i]);
+        } else if (strcmp(argv[i], "--course") == 0) {
+            options.course = true;
+        } else if (strcmp(argv[i], "--unicite") == 0) {
+            options.unicite = true;
+        } else if (strcmp(argv[i], "--toutes") == 0) {
+            options.toutes = true;
+        } else if (strcmp(argv[i], "--compter") == 0) {
+            options.compter = true;
+        } else if (strcmp(argv[i], "--paquets") == 0) {
+            options.paquets = true;
+        } else if (strcmp(argv[i], "--max-solutions") == 0 && i+1 < argc) {
+            i++;
+            options.maxSolutions = atol(argv[i]);
+            if (options.maxSolutions < 1) {
+                fprintf(stderr, "Nombre de solutions invalide : %s\n", argv[i]);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "--banc") == 0) {
+            options.banc = true;
+        } else if (strcmp(argv[i], "--echauffement") == 0 && i+1 < argc) {
+            i++;
+            options.echauffement = atoi(argv[i]);
+            if (options.echauffement < 0) {
+                fprintf(stderr, "Nombre d executions d echauffement invalide : %s\n", argv[i]);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "--repetitions") == 0 && i+1 < argc) {
+            i++;
+            options.repetitions = atoi(argv[i]);
+            if (options.repetitions < 1) {
+                fprintf(stderr, "Nombre de repetitions invalide : %s\n", argv[i]);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "--reference") == 0 && i+1 < argc) {
+            i++;
+            options.nomReference = argv[i];
+        } else if (strcmp(argv[i], "--seuil") == 0 && i+1 < argc) {
+            i++;
+            options.seuil = atof(argv[i]);
+            if (options.seuil <= 0) {
+                fprintf(stderr, "Seuil de ralentissement invalide : %s\n", argv[i]);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "--etages") == 0 && i+1 < argc) {
+            i++;
+            if (!lireEtages(argv[i], &options.etages)) {
+                fprintf(stderr, "Liste d etages invalide : %s\n", argv[i]);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "--strategies") == 0 && i+1 < argc) {
+            i++;
+            if (!lireStrategies(argv[i], &options)) {
+                fprintf(stderr, "Liste de strategies invalide : %s\n", argv[i]);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "--variante") == 0 && i+1 < argc) {
+            i++;
+            if (!lireVariante(argv[i], &variante)) {
+                fprintf(stderr, "Variante invalide : %s (x, fenetres)\n", argv[i]);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "--regions") == 0 && i+1 < argc) {
+            i++;
+            if (!chargerRegions(argv[i], &variante)) {
+                fprintf(stderr, "ERREUR. \'%s\' ne contient pas une grille de regions valide.\n", argv[i]);
+                exit(SORTIE_ERREUR_LECTURE);
+            }
+        } else if (strcmp(argv[i], "-n") == 0 && i+1 < argc) {
+            i++;
+            options.tailleBloc = atoi(argv[i]);
+            if (options.tailleBloc < N_MIN || options.tailleBloc > N_MAX) {
+                fprintf(stderr, "Taille de bloc invalide : %s (entre %d et %d)\n", argv[i], N_MIN, N_MAX);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "-j") == 0 && i+1 < argc) {
+            i++;
+            options.nbTravailleurs = atoi(argv[i]);
+            if (options.nbTravailleurs == 0) {
+                options.nbTravailleurs = nombreCoeurs();
+            }
+            if (options.nbTravailleurs < 1) {
+                fprintf(stderr, "Nombre de threads invalide : %s\n", argv[i]);
+                exit(SORTIE_USAGE);
+            }
+        } else if (strcmp(argv[i], "-o") == 0 && i+1 < argc) {
+            i++;
+            nomSortie = argv[i];
+        } else if (strcmp(argv[i], "--convertir") == 0 && i+1 < argc) {
+            i++;
+            nomCorpus = argv[i];
+        } else if (strcmp(argv[i], "--compteurs") == 0 && i+1 < argc) {
+            i++;
+            nomCompteurs = argv[i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i+1 < argc) {
+            i++;
+            nomTrace = argv[i];
+        } else if (strcmp(argv[i], "--analyser") == 0 && i+1 < argc) {
+            i++;
+            nomAnalyse = argv[i];
+        } else if (strcmp(argv[i], "--piles") == 0 && i+1 < argc) {
+            i++;
+            nomPiles = argv[i];
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "Option inconnue : %s\n", argv[i]);
+            usage(argv[0]);
+            exit(SORTIE_USAGE);
+        } else {
+            nbChemins++;
+        }
+    }
+
+    if (options.course && options.decouper) {
+        fprintf(stderr, "Les options --course et --decouper sont incompatibles.\n");
+        exit(SORTIE_USAGE);
+    }
+    if (options.unicite + options.toutes + options.compter > 1
+        || ((options.unicite || options.toutes || options.compter) && (options.course || options.decouper))) {
+        fprintf(stderr, "Les options --unicite, --toutes et --compter sont incompatibles entre elles,\n"
+                        "et avec --course et --decouper.\n");
+        exit(SORTIE_USAGE);
+    }
+    if (options.banc && (options.unicite || options.toutes || options.compter || options.course
+                         || options.decouper || nomCorpus != NULL)) {
+        fprintf(stderr, "L option --banc mesure la resolution simple, elle ne se combine pas\n"
+                        "avec --unicite, --toutes, --compter, --course, --decouper ni --convertir.\n");
+        exit(SORTIE_USAGE);
+    }
+
+    if (nomCompteurs != NULL) {
+#ifndef INSTRUMENTATION
+        fprintf(stderr, "L option --compteurs demande un programme compile avec -DINSTRUMENTATION.\n");
+        exit(SORTIE_USAGE);
+#endif
+        if (nbChemins == 0 || options.course || options.decouper || options.banc || nomCorpus != NULL) {
+            fprintf(stderr, "L option --compteurs s applique a la resolution d un lot de grilles par un thread\n"
+                            "chacune : elle ne se combine pas avec --course, --decouper, --banc ni --convertir.\n");
+            exit(SORTIE_USAGE);
+        }
+    }
+
+    // les etages de --etages s ajoutent a ceux de chaque strategie de --course et de --banc
+    for (int s = 0; s < options.nbStrategies; s++) {
+        options.strategies[s].etages |= options.etages;
+    }
+
+    if (options.paquets && (nbChemins == 0 || options.course || options.decouper || options.banc
+                            || options.unicite || options.toutes || options.compter
+                            || nomCompteurs != NULL || nomTrace != NULL)) {
+        fprintf(stderr, "L option --paquets resout un lot de grilles, elle ne se combine pas avec --course,\n"
+                        "--decouper, --banc, --unicite, --toutes, --compter, --compteurs ni --trace.\n");
+        exit(SORTIE_USAGE);
+    }
+    if (nomTrace != NULL && (nbChemins == 0 || options.course || options.decouper || options.banc
+                             || nomCorpus != NULL)) {
+        fprintf(stderr, "L option --trace s applique a la resolution d un lot de grilles par un thread\n"
+                        "chacune : elle ne se combine pas avec --course, --decouper, --banc ni --convertir.\n");
+        exit(SORTIE_USAGE);
+    }
+    if (nomPiles != NULL && nomAnalyse == NULL) {
+        fprintf(stderr, "L option --piles demande une trace a analyser (--analyser).\n");
+        exit(SORTIE_USAGE);
+    }
+    if (nomAnalyse != NULL) {
+        // analyse d une trace : aucune grille n est resolue
+        if (nbChemins > 0 || nomTrace != NULL) {
+            fprintf(stderr, "L option --analyser lit une trace existante, sans grille a resoudre.\n");
+            exit(SORTIE_USAGE);
+        }
+        return analyserFichierTrace(nomAnalyse, nomSortie, nomPiles);
+    }
+
+    if (nomCorpus != NULL && nbChemins == 0) {
+        fprintf(stderr, "--convertir a besoin de fichiers ou de dossiers a convertir.\n");
+        exit(SORTIE_USAGE);
+    }
+
+    if (nbChemins == 0 && !options.banc) {
+        // mode interactif : une seule grille choisie dans grilles/
+        void *travail = NULL;
+        double time_spent;
+        grille = chargerGrille(&options.tailleBloc);
+
+        printf("Grille initial\n");
+        afficherGrille(stdout, grille, options.tailleBloc);
+
+        if (options.decouper || options.course) {
+            // temps reel : le temps CPU additionnerait celui de tous les threads
+            tGrilleLot lue = {grille, NULL, 0, options.tailleBloc, 0, 1, RESULTAT_A_RESOUDRE, 0, -1, 0,
+#ifdef INSTRUMENTATION
+                              0, {0}
+#endif
+                             };
+            int nbThreads = options.course ? options.nbStrategies : options.nbTravailleurs;
+            void *(*travaux)[N_MAX + 1] = calloc(nbThreads, sizeof(*travaux));
+            resoudreEnsemble(&lue, &options, travaux);
+            resolue = (lue.resultat == RESULTAT_RESOLUE);
+            time_spent = lue.temps;
+            if (lue.gagnante >= 0) {
+                char nomStrategie[TAILLE_NOM_STRATEGIE];
+                nommerStrategie(&options.strategies[lue.gagnante], nomStrategie, sizeof(nomStrategie));
+                printf("Strategie gagnante : %s\n", nomStrategie);
+            }
+            for (int i = 0; i < nbThreads; i++) {
+                free(travaux[i][options.tailleBloc]);
+            }
+            free(travaux);
+        } else if (options.unicite) {
+            clock_t start = clock();
+
+            long nbSolutions = COMPTAGES[options.tailleBloc](grille, options.moteur, options.balayage, options.etages, 2, &travail);
+
+            clock_t end = clock();
+            time_spent = (double)(end - start) / CLOCKS_PER_SEC;
+            resolue = (nbSolutions > 0);
+            if (nbSolutions == 1) {
+                printf("La solution est unique\n");
+            } else if (nbSolutions > 1) {
+                printf("La grille a plusieurs solutions, en voici une\n");
+            }
+        } else if (options.toutes || options.compter) {
+            tSortieSolutions destination = {stdout, options.tailleBloc, true, grille, 0};
+            size_t tailleCases = (size_t)options.tailleBloc*options.tailleBloc*options.tailleBloc*options.tailleBloc * sizeof(int);
+            int *donnees = malloc(tailleCases);
+            long nbSolutions;
+            clock_t start = clock();
+
+            // les solutions sont affichees dans grille : la recherche part d une copie
+            memcpy(donnees, grille, tailleCases);
+            if (options.toutes) {
+                nbSolutions = ENUMERATIONS[options.tailleBloc](donnees, options.moteur, options.balayage, options.etages,
+                                                               options.maxSolutions, ecrireSolution, &destination, &travail);
+            } else {
+                nbSolutions = DENOMBREMENTS[options.tailleBloc](donnees, options.balayage, options.etages, options.maxSolutions, &travail);
+            }
+
+            clock_t end = clock();
+            time_spent = (double)(end - start) / CLOCKS_PER_SEC;
+            resolue = (nbSolutions > 0);
+            printf("%ld solution%s%s\n", nbSolutions, nbSolutions > 1 ? "s" : "",
+                   nbSolutions == options.maxSolutions ? " (limite atteinte)" : "");
+            free(donnees);
+        } else {
+            clock_t start = clock();
+
+            resolue = RESOLUTIONS[options.tailleBloc](grille, options.moteur, options.balayage, options.etages, &travail, NULL);
+
+            clock_t end = clock();
+            time_spent = (double)(end - start) / CLOCKS_PER_SEC;
+        }
+        
+        if (!resolue) {
+            printf("La grille n a pas de solution\n");
+        }
+        if (!options.toutes && !options.compter) {
+            printf("Grille finale\n");
+            afficherGrille(stdout, grille, options.tailleBloc);
+        }
+        printf("Resolution de la grille en %.6f secondes\n", time_spent);
+
+        free(travail);
+        free(grille);
+        return SORTIE_OK;
+    }
+
+    // mode lot
+    if (nomSortie != NULL) {
+        sortie = fopen(nomSortie, "w");
+        if (sortie == NULL) {
+            fprintf(stderr, "ERREUR. Impossible d ecrire dans \'%s\'.\n", nomSortie);
+            exit(SORTIE_USAGE);
+        }
+    }
+    if (nomCompteurs != NULL) {
+        options.compteurs = fopen(nomCompteurs, "w");
+        if (options.compteurs == NULL) {
+            fprintf(stderr, "ERREUR. Impossible d ecrire dans \'%s\'.\n", nomCompteurs);
+            exit(SORTIE_USAGE);
+        }
+    }
+    if (nomTrace != NULL) {
+        options.trace = fopen(nomTrace, "wb");
+        if (options.trace == NULL || !ouvrirTrace(options.trace)) {
+            fprintf(stderr, "ERREUR. Impossible d ecrire dans \'%s\'.\n", nomTrace);
+            exit(SORTIE_USAGE);
+        }
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "-o") == 0
+            || strcmp(argv[i], "--profondeur") == 0 || strcmp(argv[i], "--strategies") == 0
+            || strcmp(argv[i], "--etages") == 0 || strcmp(argv[i], "--variante") == 0
+            || strcmp(argv[i], "--regions") == 0
+            || strcmp(argv[i], "--convertir") == 0 || strcmp(argv[i], "--max-solutions") == 0
+            || strcmp(argv[i], "--echauffement") == 0 || strcmp(argv[i], "--repetitions") == 0
+            || strcmp(argv[i], "--reference") == 0 || strcmp(argv[i], "--seuil") == 0
+            || strcmp(argv[i], "--compteurs") == 0 || strcmp(argv[i], "--trace") == 0) {
+            i++;
+        } else if (argv[i][0] != '-' || argv[i][1] == '\0') {
+            chargerChemin(argv[i], &options, &lot);
+        }
+    }
+    if (options.banc) {
+        if (nbChemins == 0) {
+            chargerChemin("grilles", &options, &lot);
+        }
+        int nbRalentis = mesurerLot(&lot, &options, sortie);
+        libererLot(&lot);
+        if (sortie != stdout) {
+            fclose(sortie);
+        }
+        if (nbRalentis < 0 || lot.erreurs > 0) {
+            return SORTIE_ERREUR_LECTURE;
+        }
+        return nbRalentis > 0 ? SORTIE_RALENTI : SORTIE_OK;
+    }
+    if (nomCorpus != NULL) {
+        bool converti = convertirLot(&lot, nomCorpus);
+        if (converti) {
+            fprintf(sortie, "%d grilles ecrites dans %s\n", lot.nbGrilles, nomCorpus);
+        }
+        libererLot(&lot);
+        if (sortie != stdout) {
+            fclose(sortie);
+        }
+        return (converti && lot.erreurs == 0) ? SORTIE_OK : SORTIE_ERREUR_LECTURE;
+    }
+    if (options.toutes) {
+        enumererLot(&lot, &options, sortie, &bilan);
+    } else {
+        resoudreLot(&lot, &options);
+        ecrireLot(&lot, &options, sortie, &bilan);
+    }
+    libererLot(&lot);
+
+    if (options.toutes || options.compter) {
+        fprintf(sortie, "%d grilles avec des solutions (%ld en tout), %d sans solution, %d erreurs\n",
+                bilan.resolues, bilan.solutions, bilan.sansSolution, bilan.erreurs);
+    } else if (options.unicite) {
+        fprintf(sortie, "%d grilles a solution unique, %d a plusieurs solutions, %d sans solution, %d erreurs\n",
+                bilan.resolues, bilan.multiples, bilan.sansSolution, bilan.erreurs);
+    } else {
+        fprintf(sortie, "%d grilles resolues, %d sans solution, %d erreurs\n",
+                bilan.resolues, bilan.sansSolution, bilan.erreurs);
+    }
+    if (sortie != stdout) {
+        fclose(sortie);
+    }
+    if (options.compteurs != NULL) {
+        fclose(options.compteurs);
+    }
+    if (options.trace != NULL && fclose(options.trace) != 0) {
+        fprintf(stderr, "ERREUR. La trace \'%s\' n a pas pu etre ecrite entierement.\n", nomTrace);
+    }
+
+    if (bilan.erreurs > 0) {
+        return SORTIE_ERREUR_LECTURE;
+    }
+    if (bilan.sansSolution > 0) {
+        return SORTIE_SANS_SOLUTION;
+    }
+    if (bilan.multiples > 0) {
+        return SORTIE_MULTIPLE;
+    }
+    return SORTIE_OK;
+}
+
+/*****************************************************
+ *                    MODE LOT                       *
+ *****************************************************/
+
+/**
+ * \fn int tailleBlocDepuisNbCases(long nbCases)
+ * \brief Determine la taille de bloc d une grille a partir de son nombre de cases
+ * \param nbCases Nombre de cases de la grille
+ * 
+ * \return La taille de bloc n telle que n^4 = nbCases, ou 0 si aucune taille geree ne convient
+*/
+int tailleBlocDepuisNbCases(long nbCases) {
+    for (int k = N_MIN; k <= N_MAX; k++) {
+        if ((long)k*k*k*k == nbCases) {
+            return k;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \fn char *lireFlux(FILE *f, size_t *nbOctets)
+ * \brief Lit un flux en entier
+ * \param f Flux a lire, eventuellement non positionnable (entree standard)
+ * \param nbOctets Nombre d octets lus
+ * 
+ * \return Le contenu du flux, alloue dynamiquement, ou NULL si le flux est vide ou illisible
+*/
+char *lireFlux(FILE *f, size_t *nbOctets) {
+    struct stat infos;
+    size_t capacite = 4096;
+    size_t lus;
+    char *tampon;
+    char *nouveau;
+
+    // un fichier ordinaire est lu en une fois
+    if (fstat(fileno(f), &infos) == 0 && S_ISREG(infos.st_mode) && infos.st_size > 0) {
+        capacite = (size_t) infos.st_size + 1;
+    }
+    tampon = malloc(capacite);
+    *nbOctets = 0;
+    while (tampon != NULL && (lus = fread(tampon + *nbOctets, 1, capacite - *nbOctets, f)) > 0) {
+        *nbOctets += lus;
+        if (*nbOctets == capacite) {
+            capacite *= 2;
+            nouveau = realloc(tampon, capacite);
+            if (nouveau == NULL) {
+                free(tampon);
+            }
+            tampon = nouveau;
+        }
+    }
+    if (tampon == NULL || ferror(f) || *nbOctets == 0) {
+        free(tampon);
+        return NULL;
+    }
+    return tampon;
+}
+
+/**
+ * \fn bool grilleValide(int *grille, int tailleBloc)
+ * \brief Verifie que toutes les cases d une grille lue sont dans [0, TAILLE]
+ * \param grille Cases de la grille ligne par ligne
+ * \param tailleBloc Taille d un bloc de la grille
+ * 
+ * \return true si la grille peut etre donnee au noyau, false sinon
+*/
+bool grilleValide(int *grille, int tailleBloc) {
+    int taille = tailleBloc*tailleBloc;
+    for (int i = 0; i < taille*taille; i++) {
+        if (grille[i] < 0 || grille[i] > taille) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn double tempsCPU(void)
+ * \brief Temps CPU consomme par le thread appelant
+ * 
+ * \return Temps en secondes. Contrairement a clock(), il ne compte pas
+ * le temps des autres threads du programme.
+*/
+double tempsCPU(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * \fn int ajouterFichier(tLot *lot, const char *nom, void *contenu)
+ * \brief Ajoute un fichier au lot
+ * \param lot Lot de grilles
+ * \param nom Nom du fichier, copie
+ * \param contenu Contenu du fichier, libere avec le lot
+ * 
+ * \return Rang du fichier dans le lot
+*/
+int ajouterFichier(tLot *lot, const char *nom, void *contenu) {
+    tFichierLot *nouveau = realloc(lot->fichiers, (lot->nbFichiers + 1) * sizeof(tFichierLot));
+    if (nouveau == NULL) {
+        fprintf(stderr, "ERREUR. Memoire insuffisante.\n");
+        exit(SORTIE_ERREUR_LECTURE);
+    }
+    lot->fichiers = nouveau;
+    lot->fichiers[lot->nbFichiers].nom = strdup(nom);
+    lot->fichiers[lot->nbFichiers].contenu = contenu;
+    lot->fichiers[lot->nbFichiers].projection = NULL;
+    lot->fichiers[lot->nbFichiers].tailleProjection = 0;
+    lot->nbFichiers++;
+    return lot->nbFichiers - 1;
+}
+
+/**
+ * \fn tGrilleLot *ajouterGrilles(tLot *lot, long nbGrilles, int numFichier, int tailleBloc)
+ * \brief Ajoute au lot les grilles d un fichier, encore sans cases
+ * \param lot Lot de grilles
+ * \param nbGrilles Nombre de grilles a ajouter
+ * \param numFichier Rang de leur fichier dans le lot
+ * \param tailleBloc Taille de bloc des grilles, a corriger par l appelant si elle varie
+ * 
+ * \return Premiere grille ajoutee : l appelant remplit ses cases (ou ses cases compactees)
+*/
+tGrilleLot *ajouterGrilles(tLot *lot, long nbGrilles, int numFichier, int tailleBloc) {
+    tGrilleLot *nouveau = realloc(lot->grilles, (lot->nbGrilles + nbGrilles) * sizeof(tGrilleLot));
+
+    if (nouveau == NULL) {
+        fprintf(stderr, "ERREUR. Memoire insuffisante.\n");
+        exit(SORTIE_ERREUR_LECTURE);
+    }
+    lot->grilles = nouveau;
+    for (long i = 0; i < nbGrilles; i++) {
+        tGrilleLot *grille = &lot->grilles[lot->nbGrilles + i];
+        grille->cases = NULL;
+        grille->compacte = NULL;
+        grille->bitsCompacte = 0;
+        grille->tailleBloc = tailleBloc;
+        grille->numFichier = numFichier;
+        grille->indice = (int)i + 1;
+        grille->resultat = RESULTAT_A_RESOUDRE;
+        grille->temps = 0;
+        grille->gagnante = -1;
+        grille->nbSolutions = 0;
+    }
+    lot->nbGrilles += nbGrilles;
+    return &lot->grilles[lot->nbGrilles - nbGrilles];
+}
+
+/**
+ * \fn void chargerTexte(const char *donnees, size_t taille, const char *nom, tOptions *options, tLot *lot)
+ * \brief Ajoute au lot toutes les grilles d un texte (texte.h)
+ * \param donnees Texte lu en entier
+ * \param taille Taille du texte en octets
+ * \param nom Nom du fichier, repris dans les resultats
+ * \param options Options de la ligne de commande
+ * \param lot Lot de grilles
+ * 
+ * Les cases, d un octet chacune, ne sont converties en entiers qu au moment de
+ * resoudre chaque grille. Les lignes mal formees sont comptees comme des erreurs de
+ * lecture, les grilles bien formees du meme fichier sont tout de meme resolues.
+*/
+void chargerTexte(const char *donnees, size_t taille, const char *nom, tOptions *options, tLot *lot) {
+    tTexte lu;
+    tGrilleLot *grilles;
+    int numFichier;
+
+    if (!lireTexte(donnees, taille, options->tailleBloc, nom, &lu)) {
+        fprintf(stderr, "ERREUR. Memoire insuffisante.\n");
+        exit(SORTIE_ERREUR_LECTURE);
+    }
+    lot->erreurs += lu.erreurs;
+    if (lu.nbGrilles == 0) {
+        if (lu.erreurs == 0) {
+            fprintf(stderr, "ERREUR. Le fichier \'%s\' ne contient aucune grille.\n", nom);
+            lot->erreurs++;
+        }
+        free(lu.cases);
+        free(lu.grilles);
+        return;
+    }
+
+    numFichier = ajouterFichier(lot, nom, lu.cases);
+    grilles = ajouterGrilles(lot, lu.nbGrilles, numFichier, 0);
+    for (int i = 0; i < lu.nbGrilles; i++) {
+        grilles[i].compacte = lu.cases + lu.grilles[i].debut;
+        grilles[i].bitsCompacte = 8;
+        grilles[i].tailleBloc = lu.grilles[i].tailleBloc;
+    }
+    free(lu.grilles);
+}
+
+/**
+ * \fn void chargerFlux(FILE *f, const char *nom, tOptions *options, tLot *lot)
+ * \brief Ajoute au lot toutes les grilles d un flux au format .sud ou texte
+ * \param f Flux a lire
+ * \param nom Nom du flux, repris dans les resultats
+ * \param options Options de la ligne de commande
+ * \param lot Lot de grilles
+ * 
+ * Un flux sans octet nul est lu comme du texte (texte.h). Au format .sud, sans -n,
+ * le flux doit contenir exactement une grille, dont la taille est deduite ; avec -n,
+ * le flux peut contenir plusieurs grilles de cette taille mises bout a bout.
+*/
+void chargerFlux(FILE *f, const char *nom, tOptions *options, tLot *lot) {
+    size_t nbOctets;
+    long nbCases;
+    long casesParGrille;
+    long nbGrilles;
+    int tailleBloc;
+    int numFichier;
+    tGrilleLot *grilles;
+    char *donnees = lireFlux(f, &nbOctets);
+    int *cases = (int *) donnees;
+
+    if (donnees != NULL && estTexte(donnees, nbOctets)) {
+        chargerTexte(donnees, nbOctets, nom, options, lot);
+        free(donnees);
+        return;
+    }
+    if (donnees == NULL || nbOctets % sizeof(int) != 0) {
+        fprintf(stderr, "ERREUR. Le fichier \'%s\' est illisible ou n est pas au format .sud.\n", nom);
+        lot->erreurs++;
+        free(donnees);
+        return;
+    }
+
+    nbCases = (long)(nbOctets / sizeof(int));
+    tailleBloc = options->tailleBloc;
+    if (tailleBloc == 0) {
+        tailleBloc = tailleBlocDepuisNbCases(nbCases);
+    }
+    casesParGrille = (long)tailleBloc*tailleBloc*tailleBloc*tailleBloc;
+    if (tailleBloc == 0 || nbCases % casesParGrille != 0) {
+        fprintf(stderr, "ERREUR. Le fichier \'%s\' ne contient pas une grille de taille geree.\n", nom);
+        lot->erreurs++;
+        free(cases);
+        return;
+    }
+
+    numFichier = ajouterFichier(lot, nom, cases);
+    nbGrilles = nbCases / casesParGrille;
+    grilles = ajouterGrilles(lot, nbGrilles, numFichier, tailleBloc);
+    for (long i = 0; i < nbGrilles; i++) {
+        grilles[i].cases = cases + i*casesParGrille;
+    }
+}
+
+/**
+ * \fn void chargerChemin(const char *chemin, tOptions *options, tLot *lot)
+ * \brief Ajoute au lot les grilles d un argument du mode lot
+ * \param chemin Fichier .sud ou texte, corpus .sudc, dossier, ou - pour l entree standard
+ * \param options Options de la ligne de commande
+ * \param lot Lot de grilles
+*/
+void chargerChemin(const char *chemin, tOptions *options, tLot *lot) {
+    struct stat infos;
+    FILE *f;
+    char magie[4];
+
+    if (strcmp(chemin, "-") == 0) {
+        chargerFlux(stdin, "-", options, lot);
+    } else if (stat(chemin, &infos) == 0 && S_ISDIR(infos.st_mode)) {
+        chargerDossier(chemin, options, lot);
+    } else {
+        f = fopen(chemin, "rb");
+        if (f == NULL) {
+            fprintf(stderr, "ERREUR. Impossible d ouvrir \'%s\'.\n", chemin);
+            lot->erreurs++;
+            return;
+        }
+        if (fread(magie, 1, 4, f) == 4 && memcmp(magie, MAGIE_CORPUS, 4) == 0) {
+            fclose(f);
+            chargerCorpus(chemin, options, lot);
+            return;
+        }
+        rewind(f);
+        chargerFlux(f, chemin, options, lot);
+        fclose(f);
+    }
+}
 
 /**
- * \def n
- * \brief Taille d un bloc de la grille
+ * \fn int comparerNoms(const void *a, const void *b)
+ * \brief Compare deux noms de fichiers pour qsort
 */
-#define n 4
+int comparerNoms(const void *a, const void *b) {
+    return strcmp(*(char * const *) a, *(char * const *) b);
+}
 
 /**
- * \def TAILLE
- * \brief Taille de la grille (n*n)
+ * \fn void chargerDossier(const char *chemin, tOptions *options, tLot *lot)
+ * \brief Ajoute au lot tous les fichiers .sud et .sudc d un dossier
+ * \param chemin Chemin du dossier
+ * \param options Options de la ligne de commande
+ * \param lot Lot de grilles
+ * 
+ * Les fichiers sont pris par ordre alphabetique, pour que les resultats
+ * ne dependent pas de l ordre du systeme de fichiers. Les sous-dossiers sont ignores.
 */
-#define TAILLE (n*n)
-
+void chargerDossier(const char *chemin, tOptions *options, tLot *lot) {
+    DIR *dossier = opendir(chemin);
+    struct dirent *entree;
+    char **noms = NULL;
+    char **nouveau;
+    int nbNoms = 0;
+    size_t longueur;
+    char *fichier;
+
+    if (dossier == NULL) {
+        fprintf(stderr, "ERREUR. Impossible d ouvrir le dossier \'%s\'.\n", chemin);
+        lot->erreurs++;
+        return;
+    }
+    while ((entree = readdir(dossier)) != NULL) {
+        longueur = strlen(entree->d_name);
+        if ((longueur > 4 && strcmp(entree->d_name + longueur - 4, ".sud") == 0)
+            || (longueur > 5 && strcmp(entree->d_name + longueur - 5, ".sudc") == 0)) {
+            nouveau = realloc(noms, (nbNoms + 1) * sizeof(char *));
+            if (nouveau == NULL) {
+                break;
+            }
+            noms = nouveau;
+            noms[nbNoms] = strdup(entree->d_name);
+            nbNoms++;
+        }
+    }
+    closedir(dossier);
+
+    qsort(noms, nbNoms, sizeof(char *), comparerNoms);
+    for (int i = 0; i < nbNoms; i++) {
+        fichier = malloc(strlen(chemin) + strlen(noms[i]) + 2);
+        sprintf(fichier, "%s/%s", chemin, noms[i]);
+        chargerChemin(fichier, options, lot);
+        free(fichier);
+        free(noms[i]);
+    }
+    free(noms);
+}
 
 /**
- * \struct tCase1
- * \brief Structure representant une case de la grille
+ * \fn void chargerCorpus(const char *chemin, tOptions *options, tLot *lot)
+ * \brief Ajoute au lot toutes les grilles d un corpus compact (corpus.h)
+ * \param chemin Chemin du fichier .sudc
+ * \param options Options de la ligne de commande
+ * \param lot Lot de grilles
  * 
- * La structure tCase1 contient :
- * - valeur : la valeur de la case
- * - candidats : un tableau contenant les candidats possibles pour la case
- * - nbCandidats : le nombre de candidats possibles pour la case
+ * Le fichier est projete en memoire et n est jamais lu en entier : chaque grille
+ * du lot pointe sur ses cases compactees, decompactees au moment de la resoudre.
 */
-typedef struct {
-    int valeur;
-    int candidats[TAILLE];
-    int nbCandidats;
-} tCase1;
-
-// candidat_grille est un tableau de TAILLE lignes et TAILLE colonnes contenant les candidats possibles pour chaque case
-typedef tCase1 candidat_grille[TAILLE][TAILLE];
+void chargerCorpus(const char *chemin, tOptions *options, tLot *lot) {
+    int fd = open(chemin, O_RDONLY);
+    struct stat infos;
+    unsigned char *donnees;
+    tEnteteCorpus entete;
+    tGrilleLot *grilles;
+    int numFichier;
+
+    if (fd == -1 || fstat(fd, &infos) != 0 || infos.st_size == 0) {
+        fprintf(stderr, "ERREUR. Impossible d ouvrir \'%s\'.\n", chemin);
+        lot->erreurs++;
+        if (fd != -1) {
+            close(fd);
+        }
+        return;
+    }
+    donnees = mmap(NULL, infos.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (donnees == MAP_FAILED) {
+        fprintf(stderr, "ERREUR. Impossible de projeter \'%s\' en memoire.\n", chemin);
+        lot->erreurs++;
+        return;
+    }
+    if (!lireEnteteCorpus(donnees, infos.st_size, &entete)
+        || (options->tailleBloc != 0 && options->tailleBloc != entete.tailleBloc)) {
+        fprintf(stderr, "ERREUR. Le fichier \'%s\' n est pas un corpus valide de cette taille de bloc.\n", chemin);
+        lot->erreurs++;
+        munmap(donnees, infos.st_size);
+        return;
+    }
+    // les grilles sont lues dans l ordre
+    madvise(donnees, infos.st_size, MADV_SEQUENTIAL);
 
-// tGrille est un tableau de TAILLE lignes et TAILLE colonnes contenant la grille de jeu initiale
-typedef int tGrille[TAILLE][TAILLE];
+    numFichier = ajouterFichier(lot, chemin, NULL);
+    lot->fichiers[numFichier].projection = donnees;
+    lot->fichiers[numFichier].tailleProjection = infos.st_size;
 
+    grilles = ajouterGrilles(lot, (long) entete.nbGrilles, numFichier, entete.tailleBloc);
+    for (uint64_t i = 0; i < entete.nbGrilles; i++) {
+        grilles[i].compacte = grilleCorpus(donnees, &entete, i);
+        grilles[i].bitsCompacte = entete.bitsParCase;
+    }
+}
 
 /**
- * \def CELLULE_VIDE
- * \brief Caractere representant une cellule vide
+ * \fn bool preparerCases(tGrilleLot *grille)
+ * \brief Decompacte les cases d une grille venant d un corpus ou d un texte, si ce n est pas deja fait
+ * \param grille Grille du lot
+ * 
+ * \return true si grille->cases est utilisable, false si la memoire manque
 */
-const char CELLULE_VIDE = '.' ;
+bool preparerCases(tGrilleLot *grille) {
+    int nbCases = grille->tailleBloc*grille->tailleBloc*grille->tailleBloc*grille->tailleBloc;
 
-// Backtracking functions
-bool absentSurLigne(int valeur, candidat_grille grille_candidat, int numLigne);
-bool absentSurColonne(int valeur, candidat_grille grille_candidat, int numColonne);
-bool absentSurBloc(int valeur, candidat_grille grille_candidat, int numLigne, int numColonne);
-bool backtracking(candidat_grille grille_candidat, int numCase);
-int premiereCaseVide(candidat_grille grille_candidat);
-
-// Candidats functions
-void initGrilleCandidat(candidat_grille grille_candidat, tGrille grille);
-void initCandidat(candidat_grille grille_candidat);
-bool possible(candidat_grille grille, int num_ligne, int num_colonne, int valeur);
-void ajouterCandidat(tCase1 *laCase, int valeur);
-void retirerCandidat(tCase1 *laCase, int valeur);
-bool estCandidat(tCase1 la_case, int valeur);
-
-// Singleton nu
-bool checkSingletonNu(candidat_grille grille);
-
-// Singleton cachee
-void retirerCandidatLigne(candidat_grille grille_candidat, int num_lig, int valeur);
-void retirerCandidatColonne(candidat_grille grille, int num_col, int valeur);
-void retirerCandidatRegion(candidat_grille grille_candidat, int num_ligne, int num_colonne, int valeur);
-void checkSingletonCacheeRegion(candidat_grille grille, int num_ligne, int num_colonne, bool *action_effectuee);
-void checkSingletonCacheeLigne(candidat_grille grille_candidat, int num_ligne, bool *action_effectuee);
-void checkSingletonCacheeColonne(candidat_grille grille_candidat, int num_col, bool *action_effectuee);
-bool checkSingletonCachee(candidat_grille grille_candidat);
-
-// Misc functions
-char chargerGrille(tGrille grille);
-int nombreChiffre(int nombre);
-void afficherEspaces(int nombre_espaces);
-void afficherLigneSeparatrice(int nombre_espaces);
-void afficherGrille(candidat_grille grille_candidat);
+    if (grille->cases == NULL) {
+        grille->cases = malloc(nbCases * sizeof(int));
+        if (grille->cases == NULL) {
+            return false;
+        }
+        decompacterGrille(grille->compacte, grille->tailleBloc, grille->bitsCompacte, grille->cases);
+    }
+    return true;
+}
 
+/**
+ * \fn void relacherCases(tGrilleLot *grille)
+ * \brief Libere les cases decompactees d une grille qui ne seront pas affichees
+ * \param grille Grille du lot
+ * \param options Options de la ligne de commande
+ * 
+ * Avec --silencieux, --toutes, --compter ou --banc, les grilles resolues ne sont pas ecrites
+ * apres coup : garder leurs cases ferait grandir la memoire avec la taille du corpus.
+*/
+void relacherCases(tGrilleLot *grille, tOptions *options) {
+    if (grille->compacte != NULL && (options->silencieux || options->toutes || options->compter || options->banc)) {
+        free(grille->cases);
+        grille->cases = NULL;
+    }
+}
 
-/*****************************************************
- *                PROGRAMME PRINCIPAL                *
- *****************************************************/
+/**
+ * \fn bool convertirLot(tLot *lot, const char *nomCorpus)
+ * \brief Ecrit toutes les grilles du lot dans un corpus compact
+ * \param lot Lot de grilles, toutes de la meme taille de bloc
+ * \param nomCorpus Chemin du fichier .sudc a ecrire
+ * 
+ * \return true si le corpus est ecrit, false si les grilles sont de tailles differentes,
+ * si une grille est invalide ou en cas d erreur d ecriture
+*/
+bool convertirLot(tLot *lot, const char *nomCorpus) {
+    int **grilles = malloc((lot->nbGrilles + 1) * sizeof(int *));
+    FILE *f;
+    bool ecrit;
+
+    for (int i = 0; i < lot->nbGrilles; i++) {
+        if (!preparerCases(&lot->grilles[i]) || lot->grilles[i].tailleBloc != lot->grilles[0].tailleBloc
+            || !grilleValide(lot->grilles[i].cases, lot->grilles[i].tailleBloc)) {
+            fprintf(stderr, "ERREUR. La grille %s:%d ne peut pas rejoindre le corpus.\n",
+                    lot->fichiers[lot->grilles[i].numFichier].nom, lot->grilles[i].indice);
+            free(grilles);
+            return false;
+        }
+        grilles[i] = lot->grilles[i].cases;
+    }
+    f = fopen(nomCorpus, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "ERREUR. Impossible d ecrire dans \'%s\'.\n", nomCorpus);
+        free(grilles);
+        return false;
+    }
+    ecrit = ecrireCorpus(f, lot->nbGrilles > 0 ? lot->grilles[0].tailleBloc : N_MIN, grilles, lot->nbGrilles);
+    ecrit = (fclose(f) == 0) && ecrit;
+    free(grilles);
+    return ecrit;
+}
 
-int main() {
-    tGrille grille;
-    candidat_grille grille_candidat;
+/**
+ * \fn void resoudreTache(tPool *pool, int numTravailleur, int tache)
+ * \brief Resout une grille du lot, tache executee par un thread du pool
+ * \param pool Pool de threads, dont le contexte est un tContexteLot
+ * \param numTravailleur Numero du thread, qui choisit l etat de resolution utilise
+ * \param tache Rang de la grille dans le lot
+*/
+void resoudreTache(tPool *pool, int numTravailleur, int tache) {
+    tContexteLot *contexte = pool->contexte;
+    tGrilleLot *grille = &contexte->lot->grilles[tache];
+    double debut;
+    bool resolue;
+    long nbSolutions;
+    char nom[TAILLE_NOM_TRACE + 1];
+
+    if (!preparerCases(grille) || !grilleValide(grille->cases, grille->tailleBloc)) {
+        grille->resultat = RESULTAT_INVALIDE;
+        relacherCases(grille, contexte->options);
+        return;
+    }
 
-    chargerGrille(grille);
-    initGrilleCandidat(grille_candidat, grille);
-    initCandidat(grille_candidat);
+    if (contexte->traces != NULL) {
+        snprintf(nom, sizeof(nom), "%s:%d", contexte->lot->fichiers[grille->numFichier].nom, grille->indice);
+        traceThread = &contexte->traces[numTravailleur];
+        tracerGrille(traceThread, nom, grille->tailleBloc);
+    }
+    debut = tempsCPU();
+    if (contexte->options->unicite) {
+        nbSolutions = COMPTAGES[grille->tailleBloc](grille->cases, contexte->options->moteur, contexte->options->balayage,
+                                                    contexte->options->etages, 2, &contexte->travaux[numTravailleur][grille->tailleBloc]);
+        grille->resultat = nbSolutions == 0 ? RESULTAT_SANS_SOLUTION
+                         : nbSolutions == 1 ? RESULTAT_UNIQUE : RESULTAT_MULTIPLE;
+    } else if (contexte->options->compter) {
+        grille->nbSolutions = DENOMBREMENTS[grille->tailleBloc](grille->cases, contexte->options->balayage,
+                                                                contexte->options->etages, contexte->options->maxSolutions,
+                                                                &contexte->travaux[numTravailleur][grille->tailleBloc]);
+        grille->resultat = grille->nbSolutions > 0 ? RESULTAT_SOLUTIONS : RESULTAT_SANS_SOLUTION;
+    } else {
+        resolue = RESOLUTIONS[grille->tailleBloc](grille->cases, contexte->options->moteur, contexte->options->balayage,
+                                                  contexte->options->etages, &contexte->travaux[numTravailleur][grille->tailleBloc], NULL);
+        grille->resultat = resolue ? RESULTAT_RESOLUE : RESULTAT_SANS_SOLUTION;
+    }
+    grille->temps = tempsCPU() - debut;
+    if (traceThread != NULL) {
+        tracer(traceThread, TRACE_FIN, 0, 0, 0);
+        traceThread = NULL;
+    }
+#ifdef INSTRUMENTATION
+    noterCompteurs(grille, contexte->travaux[numTravailleur][grille->tailleBloc]);
+#endif
+    relacherCases(grille, contexte->options);
+}
 
-    bool action_effectuee = true;
-    bool tmp = true;
-    bool end_of_game = false;
+/**
+ * \fn void resoudrePaquet(tPool *pool, int numTravailleur, int tache)
+ * \brief Resout TAILLE_PAQUET grilles consecutives du lot, tache executee par un thread du pool (--paquets)
+ * \param pool Pool de threads, dont le contexte est un tContexteLot
+ * \param numTravailleur Numero du thread, qui choisit les etats de resolution utilises
+ * \param tache Rang du paquet dans le lot
+ * 
+ * Les grilles du paquet sont regroupees par taille de bloc, et les singletons de
+ * chaque groupe sont places en meme temps par REDUCTIONS. Les grilles qui demandent
+ * encore une recherche sont ensuite resolues une a une par options->moteur, a partir
+ * des cases deduites. Le temps de la reduction est partage entre les grilles du groupe.
+*/
+void resoudrePaquet(tPool *pool, int numTravailleur, int tache) {
+    tContexteLot *contexte = pool->contexte;
+    tOptions *options = contexte->options;
+    int debut = tache * TAILLE_PAQUET;
+    int fin = debut + TAILLE_PAQUET < contexte->lot->nbGrilles ? debut + TAILLE_PAQUET : contexte->lot->nbGrilles;
+    tGrilleLot *groupe[TAILLE_PAQUET];
+    int *cases[TAILLE_PAQUET];
+    tEtatPaquet etats[TAILLE_PAQUET];
+    tGrilleLot *grille;
+    double debutReduction, partReduction, debutRecherche;
+    bool resolue;
+    int nb;
+
+    for (int k = N_MIN; k <= N_MAX; k++) {
+        nb = 0;
+        for (int i = debut; i < fin; i++) {
+            grille = &contexte->lot->grilles[i];
+            if (grille->tailleBloc == k) {
+                if (!preparerCases(grille) || !grilleValide(grille->cases, k)) {
+                    grille->resultat = RESULTAT_INVALIDE;
+                    relacherCases(grille, options);
+                } else {
+                    groupe[nb] = grille;
+                    cases[nb] = grille->cases;
+                    nb++;
+                }
+            }
+        }
+        if (nb > 0) {
+            debutReduction = tempsCPU();
+            REDUCTIONS[k](cases, nb, etats, &contexte->paquets[numTravailleur][k]);
+            partReduction = (tempsCPU() - debutReduction) / nb;
+        }
 
-    printf("Grille initial\n");
-    afficherGrille(grille_candidat);
+        for (int i = 0; i < nb; i++) {
+            grille = groupe[i];
+            debutRecherche = tempsCPU();
+            if (etats[i] == PAQUET_A_CHERCHER) {
+                resolue = RESOLUTIONS[k](grille->cases, options->moteur, options->balayage, options->etages,
+                                         &contexte->travaux[numTravailleur][k], NULL);
+            } else {
+                resolue = (etats[i] == PAQUET_RESOLUE);
+            }
+            grille->resultat = resolue ? RESULTAT_RESOLUE : RESULTAT_SANS_SOLUTION;
+            grille->temps = partReduction + tempsCPU() - debutRecherche;
+            relacherCases(grille, options);
+        }
+    }
+}
 
-    clock_t start = clock();
+/**
+ * \fn void resoudreLot(tLot *lot, tOptions *options)
+ * \brief Resout toutes les grilles du lot sur options->nbTravailleurs threads
+ * \param lot Lot de grilles, dont les resultats sont remplis
+ * \param options Options de la ligne de commande
+ * 
+ * Chaque thread a son propre etat de resolution pour chaque taille de bloc :
+ * rien n est partage entre les threads pendant une resolution.
+ * Avec --decouper ou --course, les grilles sont resolues l une apres l autre,
+ * chacune par plusieurs threads (resoudreEnsemble), et le temps mesure est le temps reel.
+ * Avec --paquets, chaque tache du pool est un paquet de grilles (resoudrePaquet).
+*/
+void resoudreLot(tLot *lot, tOptions *options) {
+    tContexteLot contexte;
+    int nbTravailleurs = options->nbTravailleurs;
+    int nbTaches = lot->nbGrilles;
+    pthread_mutex_t verrouTrace = PTHREAD_MUTEX_INITIALIZER;
 
-    while (end_of_game != true) {
-        // afficherGrille(grille_candidat);
-        tmp = checkSingletonNu(grille_candidat);
-        if (!tmp)
-            action_effectuee = false;
-        while (tmp) {
-            action_effectuee = true;
-            tmp = checkSingletonNu(grille_candidat);
+    if (lot->nbGrilles == 0) {
+        return;
+    }
+    if (options->decouper || options->course) {
+        if (options->course) {
+            nbTravailleurs = options->nbStrategies;
         }
-        if (!action_effectuee) {
-            tmp = checkSingletonCachee(grille_candidat);
-            if (!tmp)
-                end_of_game = true;
-            while (tmp) {
-                action_effectuee = true;
-                tmp = checkSingletonCachee(grille_candidat);
+        contexte.travaux = calloc(nbTravailleurs, sizeof(*contexte.travaux));
+        for (int i = 0; i < lot->nbGrilles; i++) {
+            if (!preparerCases(&lot->grilles[i]) || !grilleValide(lot->grilles[i].cases, lot->grilles[i].tailleBloc)) {
+                lot->grilles[i].resultat = RESULTAT_INVALIDE;
+            } else {
+                resoudreEnsemble(&lot->grilles[i], options, contexte.travaux);
             }
+            relacherCases(&lot->grilles[i], options);
+        }
+    } else {
+        if (options->paquets) {
+            nbTaches = (lot->nbGrilles + TAILLE_PAQUET - 1) / TAILLE_PAQUET;
+        }
+        if (nbTravailleurs > nbTaches) {
+            nbTravailleurs = nbTaches;
+        }
+        contexte.lot = lot;
+        contexte.options = options;
+        contexte.travaux = calloc(nbTravailleurs, sizeof(*contexte.travaux));
+        contexte.traces = NULL;
+        if (options->trace != NULL) {
+            contexte.traces = creerTraces(options->trace, &verrouTrace, nbTravailleurs);
         }
-    }
-
-    backtracking(grille_candidat, premiereCaseVide(grille_candidat));
 
-    clock_t end = clock();
-    double time_spent = (double)(end - start) / CLOCKS_PER_SEC;
-    
-    printf("Grille finale\n");
-    afficherGrille(grille_candidat);
-    printf("Resolution de la grille en %.6f secondes\n", time_spent);
+        if (options->paquets) {
+            contexte.paquets = calloc(nbTravailleurs, sizeof(*contexte.paquets));
+            executerPool(nbTaches, nbTravailleurs, options->epingler, resoudrePaquet, &contexte);
+            for (int i = 0; i < nbTravailleurs; i++) {
+                for (int k = 0; k <= N_MAX; k++) {
+                    free(contexte.paquets[i][k]);
+                }
+            }
+            free(contexte.paquets);
+        } else {
+            executerPool(nbTaches, nbTravailleurs, options->epingler, resoudreTache, &contexte);
+        }
+        libererTraces(contexte.traces, nbTravailleurs);
+    }
 
-    return EXIT_SUCCESS;
+    for (int i = 0; i < nbTravailleurs; i++) {
+        for (int k = 0; k <= N_MAX; k++) {
+            free(contexte.travaux[i][k]);
+        }
+    }
+    free(contexte.travaux);
 }
 
 /**
- * \fn bool absentSurLigne(int valeur, candidat_grille grille_candidat, int numLigne
- * \brief Verifie si une valeur est absente sur une ligne
- * \param valeur Valeur dont on veut verifier l absence sur la ligne
- * \param grille_candidat Grille de jeu
- * \param numLigne Numero de la ligne de la case selectionnee
+ * \fn void ecrireResultat(tLot *lot, tGrilleLot *grille, tOptions *options, FILE *sortie, tBilan *bilan)
+ * \brief Ecrit le resultat d une grille du lot et le compte dans le bilan
+ * \param lot Lot de grilles
+ * \param grille Grille du lot, resolue
+ * \param options Options de la ligne de commande
+ * \param sortie Flux ou ecrire le resultat
+ * \param bilan Bilan du mode lot, complete
  * 
- * \return true si la valeur est absente sur la ligne, false sinon
+ * Ecrit une ligne "nom:indice resultat temps", completee par la strategie gagnante
+ * avec --course, ou "nom:indice solutions nombre temps" avec --toutes et --compter,
+ * suivie de la grille resolue sauf avec --silencieux.
 */
-bool absentSurLigne(int valeur, candidat_grille grille_candidat, int numLigne) {
-    int i;
-    bool absent = true;
-    i = 0;
-    while (i < TAILLE && absent) {
-        if (grille_candidat[numLigne][i].valeur == valeur) {
-            absent = false;
+void ecrireResultat(tLot *lot, tGrilleLot *grille, tOptions *options, FILE *sortie, tBilan *bilan) {
+    const char *nom = lot->fichiers[grille->numFichier].nom;
+    char strategie[TAILLE_NOM_STRATEGIE];
+
+    if (grille->resultat == RESULTAT_INVALIDE) {
+        fprintf(sortie, "%s:%d %s\n", nom, grille->indice, NOMS_RESULTATS[grille->resultat]);
+    } else if (grille->resultat == RESULTAT_SOLUTIONS) {
+        fprintf(sortie, "%s:%d %s %ld %.6f\n", nom, grille->indice, NOMS_RESULTATS[grille->resultat],
+                grille->nbSolutions, grille->temps);
+    } else if (grille->gagnante >= 0) {
+        nommerStrategie(&options->strategies[grille->gagnante], strategie, sizeof(strategie));
+        fprintf(sortie, "%s:%d %s %.6f %s\n", nom, grille->indice, NOMS_RESULTATS[grille->resultat], grille->temps,
+                strategie);
+    } else {
+        fprintf(sortie, "%s:%d %s %.6f\n", nom, grille->indice, NOMS_RESULTATS[grille->resultat], grille->temps);
+    }
+    if (grille->resultat == RESULTAT_SOLUTIONS) {
+        // les solutions ont ete ecrites pendant la recherche, ou seulement comptees
+        bilan->resolues++;
+        bilan->solutions += grille->nbSolutions;
+    } else if (grille->resultat == RESULTAT_RESOLUE || grille->resultat == RESULTAT_UNIQUE
+               || grille->resultat == RESULTAT_MULTIPLE) {
+        if (grille->resultat == RESULTAT_MULTIPLE) {
+            bilan->multiples++;
+        } else {
+            bilan->resolues++;
         }
-        i++;
+        if (!options->silencieux) {
+            // avec plusieurs solutions, la premiere trouvee
+            afficherGrille(sortie, grille->cases, grille->tailleBloc);
+        }
+    } else if (grille->resultat == RESULTAT_SANS_SOLUTION) {
+        bilan->sansSolution++;
+    } else {
+        bilan->erreurs++;
     }
-    return absent;
+#ifdef INSTRUMENTATION
+    if (options->compteurs != NULL) {
+        ecrireCompteurs(lot, grille, options);
+    }
+#endif
 }
 
+#ifdef INSTRUMENTATION
 /**
- * \fn bool absentSurColonne(int valeur, candidat_grille grille_candidat, int numColonne)
- * \brief Verifie si une valeur est absente sur une colonne
- * \param valeur Valeur dont on veut verifier l absence sur la colonne
- * \param grille_candidat Grille de jeu
- * \param numColonne Numero de la colonne de la case selectionnee
- * 
- * \return true si la valeur est absente sur la colonne, false sinon
+ * \fn void noterCompteurs(tGrilleLot *grille, void *travail)
+ * \brief Garde avec une grille du lot les compteurs de sa resolution
+ * \param grille Grille du lot, qui vient d etre resolue
+ * \param travail Etat de resolution utilise, qui servira ensuite a d autres grilles
 */
-bool absentSurColonne(int valeur, candidat_grille grille_candidat, int numColonne) {
-    int i;
-    bool absent = true;
-    i = 0;
-    while (i < TAILLE && absent) {
-        if (grille_candidat[i][numColonne].valeur == valeur) {
-            absent = false;
-        }
-        i++;
+void noterCompteurs(tGrilleLot *grille, void *travail) {
+    const tCompteurs *compteurs = COMPTEURS[grille->tailleBloc](travail);
+
+    grille->nbNoeuds = NOEUDS[grille->tailleBloc](travail);
+    if (compteurs != NULL) {
+        grille->compteurs = *compteurs;
     }
-    return absent;
 }
 
 /**
- * \fn bool absentSurBloc(int valeur, candidat_grille grille_candidat, int numLigne, int numColonne)
- * \brief Verifie si une valeur est absente sur un bloc
- * \param valeur Valeur dont on veut verifier l absence sur le bloc
- * \param grille_candidat Grille de jeu
- * \param numLigne Numero de la ligne de la case selectionnee
- * \param numColonne Numero de la colonne de la case selectionnee
+ * \fn void ecrireCompteurs(tLot *lot, tGrilleLot *grille, tOptions *options)
+ * \brief Ecrit les compteurs de la resolution d une grille sur une ligne JSON (--compteurs)
+ * \param lot Lot de grilles
+ * \param grille Grille du lot, resolue
+ * \param options Options de la ligne de commande, dont le fichier des compteurs
  * 
- * \return true si la valeur est absente sur le bloc, false sinon
+ * Le temps de branchement est le temps de la recherche hors propagation : choix des
+ * cases, essais des valeurs et retours en arriere.
 */
-bool absentSurBloc(int valeur, candidat_grille grille_candidat, int numLigne, int numColonne) {
-    int startingRow = numLigne - (numLigne%n);
-    int startingCol = numColonne - (numColonne%n);
-
-    int i, j;
-    bool absent = true;
-    i = startingRow;
-    while (i < startingRow + n && absent) {
-        j = startingCol;
-        while (j < startingCol + n && absent) {
-            if (grille_candidat[i][j].valeur == valeur) {
-                absent = false;
-            }
-            j++;
+void ecrireCompteurs(tLot *lot, tGrilleLot *grille, tOptions *options) {
+    const tCompteurs *compteurs = &grille->compteurs;
+    FILE *f = options->compteurs;
+    tStrategie utilisee = {options->moteur, options->balayage, options->etages};
+    char nom[1024], grilleJson[1024], strategie[TAILLE_NOM_STRATEGIE];
+
+    // --unicite et --toutes utilisent la recherche iterative, --compter toujours avec propagation
+    if (options->compter || ((options->unicite || options->toutes) && utilisee.moteur != MOTEUR_ITERATIF)) {
+        utilisee.moteur = MOTEUR_MAC;
+    }
+    nommerStrategie(&utilisee, strategie, sizeof(strategie));
+
+    snprintf(nom, sizeof(nom), "%s:%d", lot->fichiers[grille->numFichier].nom, grille->indice);
+    echapperJson(nom, grilleJson, sizeof(grilleJson));
+    fprintf(f, "{\"grille\":\"%s\",\"n\":%d,\"strategie\":\"%s\",\"resultat\":\"%s\"",
+            grilleJson, grille->tailleBloc, strategie, NOMS_RESULTATS[grille->resultat]);
+    if (grille->resultat != RESULTAT_INVALIDE) {
+        fprintf(f, ",\"noeuds\":%ld,\"retours\":%ld,\"profondeur_max\":%d,"
+                   "\"cases_vides\":%d,\"cases_logique\":%d,\"cases_recherche\":%d",
+                grille->nbNoeuds, compteurs->retours, compteurs->profondeurMax,
+                compteurs->casesVides, compteurs->casesLogique, compteurs->casesVides - compteurs->casesLogique);
+        fprintf(f, ",\"eliminations\":{");
+        for (int t = 0; t < NB_TECHNIQUES; t++) {
+            fprintf(f, "%s\"%s\":%ld", t > 0 ? "," : "", NOMS_TECHNIQUES[t], compteurs->eliminations[t]);
+        }
+        fprintf(f, "},\"placements\":{");
+        for (int t = 0; t < NB_TECHNIQUES; t++) {
+            fprintf(f, "%s\"%s\":%ld", t > 0 ? "," : "", NOMS_TECHNIQUES[t], compteurs->placements[t]);
         }
-        i++;
+        fprintf(f, "},\"temps_logique_s\":%.9f,\"temps_propagation_s\":%.9f,\"temps_branchement_s\":%.9f"
+                   ",\"temps_etages_s\":%.9f,\"palier\":{\"essais\":%d,\"succes\":%d,\"temps_s\":%.9f}",
+                compteurs->tempsLogique, compteurs->tempsPropagation,
+                compteurs->tempsRecherche - compteurs->tempsPropagation, compteurs->tempsEtages,
+                compteurs->essaisPalier, compteurs->succesPalier, compteurs->tempsPalier);
+    }
+    fprintf(f, "}\n");
+}
+#endif
+
+/**
+ * \fn void ecrireLot(tLot *lot, tOptions *options, FILE *sortie, tBilan *bilan)
+ * \brief Ecrit les resultats du lot dans l ordre des grilles
+ * \param lot Lot de grilles resolues
+ * \param options Options de la ligne de commande
+ * \param sortie Flux ou ecrire les resultats
+ * \param bilan Bilan du mode lot, rempli
+*/
+void ecrireLot(tLot *lot, tOptions *options, FILE *sortie, tBilan *bilan) {
+    bilan->erreurs += lot->erreurs;
+    for (int i = 0; i < lot->nbGrilles; i++) {
+        ecrireResultat(lot, &lot->grilles[i], options, sortie, bilan);
     }
-    return absent;
 }
 
 /**
- * \fn bool backtracking(candidat_grille grille_candidat, int numCase)
- * \brief Resout la grille de jeu par backtracking
- * \param grille_candidat Grille de jeu
- * \param numCase Numero de la case a traiter
+ * \fn bool ecrireSolution(const unsigned char *valeurs, void *contexte)
+ * \brief Ecrit une solution enumeree par --toutes, rappel passe au noyau
+ * \param valeurs Cases de la solution ligne par ligne
+ * \param contexte Destination de la solution (tSortieSolutions)
  * 
- * \return true si la grille est resolue, false sinon
+ * \return true, pour que l enumeration continue
  * 
- * Cette fonction resout la grille de jeu par backtracking.
- * Elle verifie si la case est vide, si oui, elle teste toutes les valeurs possibles
- * et si une valeur est autorisee, elle l inscrit dans la case et passe a la case suivante.
- * Si aucune valeur n est autorisee, elle revient en arriere et teste une autre valeur.
- * Si la case n est pas vide, elle passe a la case suivante.
+ * En mode lot, une solution est ecrite sur une ligne que texte.h sait relire :
+ * un caractere par case (1 a 9, puis A pour 10, B pour 11...) jusqu a n = 5,
+ * et les nombres separes par des espaces au-dela.
 */
-bool backtracking(candidat_grille grille_candidat, int numCase){
-    int lig, col;
-    bool res = false;
-
-    if(numCase == TAILLE*TAILLE){
-        // On a traité tout les cases, la grille est résolue
-        res = true;
+bool ecrireSolution(const unsigned char *valeurs, void *contexte) {
+    tSortieSolutions *destination = contexte;
+    int nbCases = destination->tailleBloc*destination->tailleBloc*destination->tailleBloc*destination->tailleBloc;
+    char ligne[5*5*5*5 + 1];
+
+    destination->nb++;
+    if (destination->enGrille) {
+        for (int k = 0; k < nbCases; k++) {
+            destination->cases[k] = valeurs[k];
+        }
+        fprintf(destination->sortie, "Solution %ld\n", destination->nb);
+        afficherGrille(destination->sortie, destination->cases, destination->tailleBloc);
+    } else if (destination->tailleBloc <= 5) {
+        for (int k = 0; k < nbCases; k++) {
+            ligne[k] = (char) (valeurs[k] <= 9 ? '0' + valeurs[k] : 'A' + valeurs[k] - 10);
+        }
+        ligne[nbCases] = '\n';
+        fwrite(ligne, 1, nbCases + 1, destination->sortie);
     } else {
-        // On récupère les "coordonnées" de la case
-        lig = numCase / TAILLE;
-        col = numCase % TAILLE;
-        if (grille_candidat[lig][col].valeur != 0) {
-            // La case n'est pas vide, on passe à la suivante
-            // (appel récursif)
-            res = backtracking(grille_candidat, numCase+1);
-        } else {
-            for (int val = 1; val <= TAILLE; val++) {
-                if (absentSurLigne(val, grille_candidat, lig)
-                && absentSurColonne(val, grille_candidat, col)
-                && absentSurBloc(val, grille_candidat, lig, col)) {
-                    // Si la valeur est autorisée, on l'inscrit dans la case
-                    grille_candidat[lig][col].valeur = val;
-                    // Et on passe à la case suivante : appel récursif
-                    // pour voir si ce choix est bon par la suite
-                    if (backtracking(grille_candidat, numCase+1) == true) {
-                        res = true;
-                    } else {
-                        grille_candidat[lig][col].valeur = 0;
-                    }
-                }
-            }
-        } 
+        for (int k = 0; k < nbCases; k++) {
+            fprintf(destination->sortie, "%d%c", valeurs[k], k + 1 < nbCases ? ' ' : '\n');
+        }
     }
-    return res;
+    return true;
 }
 
 /**
- * \fn int premiereCaseVide(candidat_grille grille_candidat)
- * \brief Determine la premiere case vide de la grille
- * \param grille_candidat Grille de jeu
- * 
- * \return Numero de la premiere case vide de la grille
+ * \fn void enumererLot(tLot *lot, tOptions *options, FILE *sortie, tBilan *bilan)
+ * \brief Ecrit toutes les solutions de chaque grille du lot, au fil de la recherche (--toutes)
+ * \param lot Lot de grilles
+ * \param options Options de la ligne de commande
+ * \param sortie Flux ou ecrire les solutions et les resultats
+ * \param bilan Bilan du mode lot, rempli
  * 
- * Cette fonction determine la premiere case vide de la grille
- * en parcourant la grille de gauche a droite et de haut en bas.
- * Si aucune case vide n est trouvee, la fonction retourne -1.
+ * Les grilles sont traitees l une apres l autre par le thread appelant, pour que
+ * les solutions sortent dans l ordre sans etre gardees en memoire. Les solutions
+ * d une grille (aucune avec --silencieux) precedent la ligne de son resultat.
 */
-int premiereCaseVide(candidat_grille grille_candidat) {
-    int i, j;
-    bool trouve = false;
-    i = 0;
-    while (i < TAILLE && !trouve) {
-        j = 0;
-        while (j < TAILLE && !trouve) {
-            if (grille_candidat[i][j].valeur == 0) {
-                trouve = true;
+void enumererLot(tLot *lot, tOptions *options, FILE *sortie, tBilan *bilan) {
+    void *travaux[N_MAX + 1] = {NULL};
+    tSortieSolutions destination = {sortie, N_MIN, false, NULL, 0};
+    double debut;
+    pthread_mutex_t verrouTrace = PTHREAD_MUTEX_INITIALIZER;
+    tTrace *trace = NULL;
+    char nom[TAILLE_NOM_TRACE + 1];
+
+    bilan->erreurs += lot->erreurs;
+    if (options->trace != NULL) {
+        trace = creerTraces(options->trace, &verrouTrace, 1);
+    }
+    for (int i = 0; i < lot->nbGrilles; i++) {
+        tGrilleLot *grille = &lot->grilles[i];
+
+        if (!preparerCases(grille) || !grilleValide(grille->cases, grille->tailleBloc)) {
+            grille->resultat = RESULTAT_INVALIDE;
+        } else {
+            destination.tailleBloc = grille->tailleBloc;
+            if (trace != NULL) {
+                snprintf(nom, sizeof(nom), "%s:%d", lot->fichiers[grille->numFichier].nom, grille->indice);
+                traceThread = trace;
+                tracerGrille(trace, nom, grille->tailleBloc);
             }
-            j++;
+            debut = tempsCPU();
+            grille->nbSolutions = ENUMERATIONS[grille->tailleBloc](grille->cases, options->moteur, options->balayage, options->etages,
+                                                                   options->maxSolutions,
+                                                                   options->silencieux ? NULL : ecrireSolution,
+                                                                   &destination, &travaux[grille->tailleBloc]);
+            grille->temps = tempsCPU() - debut;
+            if (trace != NULL) {
+                tracer(trace, TRACE_FIN, 0, 0, 0);
+                traceThread = NULL;
+            }
+            grille->resultat = grille->nbSolutions > 0 ? RESULTAT_SOLUTIONS : RESULTAT_SANS_SOLUTION;
+#ifdef INSTRUMENTATION
+            noterCompteurs(grille, travaux[grille->tailleBloc]);
+#endif
         }
-        i++;
+        ecrireResultat(lot, grille, options, sortie, bilan);
+        relacherCases(grille, options);
+    }
+    for (int k = 0; k <= N_MAX; k++) {
+        free(travaux[k]);
     }
-    return (i-1)*TAILLE + (j-1);
+    libererTraces(trace, 1);
 }
 
-/*****************************************************
- *                FONCTIONS CANDIDATS                *
- *****************************************************/
-
-/** 
- * \fn void afficherCandidats(tCase1 laCase)
- * \brief Affiche les candidats d une case
- * \param laCase Case dont on veut afficher les candidats
- * 
- * Cette fonction affiche les candidats d une case en parcourant
- * la liste des candidats de la case.
+/**
+ * \fn tTrace *creerTraces(FILE *f, pthread_mutex_t *verrou, int nb)
+ * \brief Prepare le tampon de trace de chaque thread qui resout le lot (--trace)
+ * \param f Fichier de trace, dont l en-tete est ecrit
+ * \param verrou Verrou qui protege f
+ * \param nb Nombre de threads
+ *
+ * \return Tampons des threads, ou NULL si la memoire manque : le lot est alors resolu sans trace
 */
-void afficherCandidats(tCase1 laCase) {
-    int i;
-    for (i = 0; i < laCase.nbCandidats; i++) {
-        printf("%d ", laCase.candidats[i]);
+tTrace *creerTraces(FILE *f, pthread_mutex_t *verrou, int nb) {
+    tTrace *traces = malloc(nb * sizeof(tTrace));
+    bool prets = (traces != NULL);
+
+    for (int i = 0; i < nb && prets; i++) {
+        if (!initTrace(&traces[i], f, verrou, i)) {
+            libererTraces(traces, i + 1);
+            prets = false;
+        }
     }
-    printf("\n");
+    if (!prets) {
+        fprintf(stderr, "ERREUR. Memoire insuffisante, le lot est resolu sans trace.\n");
+        return NULL;
+    }
+    return traces;
 }
 
 /**
- * \fn void ajouterCandidat(tCase1 *laCase, int valeur)
- * \brief Ajoute un candidat a une case
- * \param laCase Case a laquelle on veut ajouter un candidat
- * \param valeur Valeur a ajouter a la liste des candidats de la case
- * 
- * Cette fonction ajoute un candidat a une case en verifiant si la valeur
- * n est pas deja presente dans la liste des candidats de la case.
+ * \fn void libererTraces(tTrace *traces, int nb)
+ * \brief Ecrit ce qui reste dans le tampon de chaque thread, et libere les tampons
+ * \param traces Tampons des threads, ou NULL
+ * \param nb Nombre de threads
 */
-void ajouterCandidat(tCase1 *laCase, int valeur) {
-    laCase->candidats[laCase->nbCandidats] = valeur;
-    laCase->nbCandidats++;
+void libererTraces(tTrace *traces, int nb) {
+    if (traces == NULL) {
+        return;
+    }
+    for (int i = 0; i < nb; i++) {
+        fermerTrace(&traces[i]);
+    }
+    free(traces);
 }
 
 /**
- * \fn void retirerCandidat(tCase1 *laCase, int valeur)
- * \brief Retire un candidat d une case
- * \param laCase Case dont on veut retirer un candidat
- * \param valeur Valeur a retirer de la liste des candidats de la case
- * 
- * Cette fonction retire un candidat d une case en verifiant si la valeur
- * est presente dans la liste des candidats de la case.
+ * \fn int analyserFichierTrace(const char *nomTrace, const char *nomSortie, const char *nomPiles)
+ * \brief Resume la recherche de chaque grille d une trace ecrite avec --trace (--analyser)
+ * \param nomTrace Nom du fichier de trace
+ * \param nomSortie Fichier ou ecrire le resume (-o), ou NULL pour la sortie standard
+ * \param nomPiles Fichier ou ecrire les piles repliees (--piles), ou NULL
+ *
+ * \return Code de sortie du programme
 */
-void retirerCandidat(tCase1 *laCase, int valeur) {
-    int i, j;
-    bool trouve = false;
-    i = 0;
+int analyserFichierTrace(const char *nomTrace, const char *nomSortie, const char *nomPiles) {
+    FILE *f = fopen(nomTrace, "rb");
+    FILE *sortie = stdout;
+    FILE *piles = NULL;
+    int nbGrilles;
+
+    if (f == NULL) {
+        fprintf(stderr, "ERREUR. Impossible de lire \'%s\'.\n", nomTrace);
+        return SORTIE_ERREUR_LECTURE;
+    }
+    if (nomSortie != NULL) {
+        sortie = fopen(nomSortie, "w");
+    }
+    if (nomPiles != NULL) {
+        piles = fopen(nomPiles, "w");
+    }
+    if (sortie == NULL || (nomPiles != NULL && piles == NULL)) {
+        fprintf(stderr, "ERREUR. Impossible d ecrire dans \'%s\'.\n", sortie == NULL ? nomSortie : nomPiles);
+        exit(SORTIE_USAGE);
+    }
 
-    if (laCase->valeur != 0)
-        return;
+    nbGrilles = analyserTrace(f, sortie, piles);
+    if (nbGrilles < 0) {
+        fprintf(stderr, "ERREUR. \'%s\' n est pas une trace valide.\n", nomTrace);
+    }
 
-    while (i < laCase->nbCandidats && !trouve) {
-        if (laCase->candidats[i] == valeur) {
-            j = i;
-            trouve = true;
-            laCase->nbCandidats--;
-            while (j != laCase->nbCandidats) {
-                laCase->candidats[j] = laCase->candidats[j+1];
-                j++;
-            }
-        }
-        i++;
+    fclose(f);
+    if (sortie != stdout) {
+        fclose(sortie);
     }
+    if (piles != NULL) {
+        fclose(piles);
+    }
+    return nbGrilles < 0 ? SORTIE_ERREUR_LECTURE : SORTIE_OK;
 }
 
 /**
- * \fn bool estCandidat(tCase1 laCase, int valeur)
- * \brief Verifie si une valeur est un candidat d une case
- * \param laCase Case dont on veut verifier si la valeur est un candidat
- * \param valeur Valeur dont on veut verifier si elle est un candidat de la case
- * 
- * \return true si la valeur est un candidat de la case, false sinon
- * 
- * Cette fonction verifie si la valeur est un candidat de la case en verifiant
- * si la valeur est presente dans la liste des candidats de la case.
+ * \fn void libererLot(tLot *lot)
+ * \brief Libere les grilles et les fichiers du lot, et ferme les projections des corpus
+ * \param lot Lot de grilles
 */
-bool estCandidat(tCase1 laCase, int valeur) {
-    int i;
-    bool trouve = false;
-    i = 0;
-    while (i < laCase.nbCandidats && !trouve) {
-        if (laCase.candidats[i] == valeur) {
-            trouve = true;
+void libererLot(tLot *lot) {
+    for (int i = 0; i < lot->nbGrilles; i++) {
+        if (lot->grilles[i].compacte != NULL) {
+            free(lot->grilles[i].cases);
+        }
+    }
+    for (int i = 0; i < lot->nbFichiers; i++) {
+        free(lot->fichiers[i].nom);
+        free(lot->fichiers[i].contenu);
+        if (lot->fichiers[i].projection != NULL) {
+            munmap(lot->fichiers[i].projection, lot->fichiers[i].tailleProjection);
         }
-        i++;
     }
-    return trouve;
+    free(lot->fichiers);
+    free(lot->grilles);
 }
 
 /**
- * \fn int nbCandidats(tCase1 laCase)
- * \brief Retourne le nombre de candidats d une case
- * \param laCase Case dont on veut connaitre le nombre de candidats
- * 
- * \return Nombre de candidats de la case
+ * \fn void usage(const char *programme)
+ * \brief Affiche la syntaxe de la ligne de commande
+ * \param programme Nom du programme
 */
-int nbCandidats(tCase1 laCase) {
-    return laCase.nbCandidats;
+void usage(const char *programme) {
+    fprintf(stderr, "Usage : %s [--mrv | --iteratif | --mac] [--balayage] [-n taille_bloc]\n", programme);
+    fprintf(stderr, "        [--silencieux] [-o sortie] [-j threads] [--epingler] [--decouper [--profondeur p]]\n");
+    fprintf(stderr, "        [--course [--strategies mac,ligne-balayage,mac+bloques,...]] [--unicite] [--convertir corpus.sudc]\n");
+    fprintf(stderr, "        [--etages bloques,paires,triplets,quadruplets,paires-cachees,triplets-caches,quadruplets-caches,\n");
+    fprintf(stderr, "                  poissons,coloriage]\n");
+    fprintf(stderr, "        [--toutes | --compter] [--max-solutions nombre] [--paquets]\n");
+    fprintf(stderr, "        [--variante x,fenetres] [--regions regions.txt]\n");
+    fprintf(stderr, "        [--banc [--echauffement e] [--repetitions r] [--reference mesures.json [--seuil pct]]]\n");
+    fprintf(stderr, "        [--compteurs compteurs.json] [--trace trace.bin]\n");
+    fprintf(stderr, "        [fichier.sud | grilles.txt | corpus.sudc | dossier | -]...\n");
+    fprintf(stderr, "       %s --analyser trace.bin [--piles piles.txt] [-o resume.txt]\n", programme);
 }
 
+/*****************************************************
+ *               RESOLUTION PARTAGEE                 *
+ *****************************************************/
 
 /**
- * \fn void initGrilleCandidat(candidat_grille grilleCandidat, tGrille grille)
- * \brief Initialise la grille de candidats
- * \param grille_candidat Grille de candidats
- * \param grille Grille de jeu
+ * \fn double tempsEcoule(void)
+ * \brief Temps ecoule depuis un instant fixe, independant des threads
  * 
- * Cette fonction initialise la grille de candidats en copiant la grille de jeu
- * dans la grille de candidats et en initialisant le nombre de candidats de chaque case a 0.
+ * \return Temps en secondes, a comparer avec un autre appel
 */
-void initGrilleCandidat(candidat_grille grille_candidat, tGrille grille) {
-    for (int i = 0; i < TAILLE; i++) {
-        for (int j = 0; j < TAILLE; j++) {
-            grille_candidat[i][j].valeur = grille[i][j];
-            grille_candidat[i][j].nbCandidats = 0;
-        }
-    }
+double tempsEcoule(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
 }
 
 /**
- * \fn bool possible(tGrille grille, int numLigne, int numColonne, int valeur)
- * \brief Verifie si une valeur peut etre inseree dans une case
- * \param grille Grille de jeu
- * \param numLigne Numero de la ligne de la case selectionnee
- * \param numColonne Numero de la colonne de la case selectionnee
- * \param valeur Valeur a inserer dans la case selectionnee
+ * \fn bool donnerTache(tDonneur *donneur, int *cases)
+ * \brief Ajoute une branche de la recherche aux taches du pool
+ * \param donneur Thread qui donne la branche
+ * \param cases Cases de la grille de depart de la branche, copiees
  * 
- * \return true si la valeur peut etre inseree, false sinon
+ * \return true si la tache est deposee, false si la memoire manque
  * 
- * Cette fonction verifie si la valeur peut etre inseree dans la case
- * selectionnee en verifiant si la valeur n est pas deja presente dans
- * la ligne, la colonne ou le bloc de la case selectionnee.
+ * La tache est deposee dans la deque du donneur, d ou les threads inactifs la volent.
 */
-bool possible(candidat_grille grille, int numLigne, int numColonne, int valeur) {
-    int i, j;
-    bool possible = true;
-
-    // check colonne
-    i = 0;
-    while (i < TAILLE && possible) {
-        if (grille[numLigne][i].valeur == valeur) {
-            // printf("La valeur %d ne peut pas être placée dans la ligne %d\ncar elle est déjà présente dans la même ligne à la colonne %d\n", valeur, numLigne+1, i+1);
-            possible = false;
+bool donnerTache(tDonneur *donneur, int *cases) {
+    tPartage *partage = donneur->partage;
+    int nbCases = partage->tailleBloc*partage->tailleBloc*partage->tailleBloc*partage->tailleBloc;
+    int *copie = malloc(nbCases * sizeof(int));
+    int **nouveau;
+    int tache = -1;
+
+    if (copie == NULL) {
+        return false;
+    }
+    memcpy(copie, cases, nbCases * sizeof(int));
+
+    pthread_mutex_lock(&partage->verrou);
+    if (partage->nbTaches == partage->capacite) {
+        nouveau = realloc(partage->taches, 2 * partage->capacite * sizeof(int *));
+        if (nouveau != NULL) {
+            partage->taches = nouveau;
+            partage->capacite *= 2;
         }
-        i++;
     }
-
-    // check ligne
-    i = 0;
-    while (i < TAILLE && possible) {
-        if (grille[i][numColonne].valeur == valeur) {
-            // printf("La valeur %d ne peut pas être placée dans la colonne %d\ncar elle est déjà présente dans la même colonne à la ligne %d\n", valeur, numColonne+1, i+1);
-            possible = false;
+    if (partage->nbTaches < partage->capacite) {
+        tache = partage->nbTaches;
+        partage->taches[tache] = copie;
+        partage->nbTaches++;
+    }
+    pthread_mutex_unlock(&partage->verrou);
+
+    if (tache == -1 || !deposerTache(donneur->pool, donneur->numTravailleur, tache)) {
+        // la tache reste dans la table, vide, et sera liberee avec elle
+        if (tache != -1) {
+            pthread_mutex_lock(&partage->verrou);
+            partage->taches[tache] = NULL;
+            pthread_mutex_unlock(&partage->verrou);
         }
-        i++;
+        free(copie);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \fn void resoudreSousArbre(tPool *pool, int numTravailleur, int tache)
+ * \brief Resout une branche d une grille partagee, tache executee par un thread du pool
+ * \param pool Pool de threads, dont le contexte est un tPartage
+ * \param numTravailleur Numero du thread
+ * \param tache Numero de la branche dans partage->taches
+*/
+void resoudreSousArbre(tPool *pool, int numTravailleur, int tache) {
+    tPartage *partage = pool->contexte;
+    tDonneur donneur = {pool, numTravailleur, &partage->arret, partage->profondeurMax, partage};
+    bool attendu = false;
+    int *cases;
+
+    pthread_mutex_lock(&partage->verrou);
+    cases = partage->taches[tache];
+    partage->taches[tache] = NULL;
+    pthread_mutex_unlock(&partage->verrou);
+
+    if (!atomic_load(&partage->arret)
+        && RESOLUTIONS[partage->tailleBloc](cases, partage->moteur, partage->balayage, partage->etages,
+                                            &partage->travaux[numTravailleur][partage->tailleBloc], &donneur)
+        && atomic_compare_exchange_strong(&partage->arret, &attendu, true)) {
+        // premiere solution trouvee : les autres threads s arretent
+        memcpy(partage->solution, cases,
+               partage->tailleBloc*partage->tailleBloc*partage->tailleBloc*partage->tailleBloc * sizeof(int));
     }
+    free(cases);
+}
 
-    // check region
-    int startingRow = numLigne - (numLigne%n);
-    int startingCol = numColonne - (numColonne%n);
+/**
+ * \fn bool resoudreDecoupe(int *grille, int tailleBloc, tOptions *options, void *(*travaux)[N_MAX + 1])
+ * \brief Resout une grille avec options->nbTravailleurs threads qui se partagent sa recherche
+ * \param grille Cases de la grille ligne par ligne, remplacees par la solution
+ * \param tailleBloc Taille d un bloc de la grille
+ * \param options Options de la ligne de commande
+ * \param travaux Etat de resolution de chaque thread, par taille de bloc
+ * 
+ * \return true si la grille est resolue, false si elle n a pas de solution
+ * 
+ * Un thread commence la recherche (iterative) ; des qu un thread est inactif,
+ * les threads occupes lui donnent les valeurs pas encore essayees de leurs choix
+ * les moins profonds (jusqu a --profondeur). Le premier thread qui trouve
+ * une solution arrete les autres.
+*/
+bool resoudreDecoupe(int *grille, int tailleBloc, tOptions *options, void *(*travaux)[N_MAX + 1]) {
+    tPartage partage;
+    int nbCases = tailleBloc*tailleBloc*tailleBloc*tailleBloc;
+
+    partage.tailleBloc = tailleBloc;
+    partage.moteur = (options->moteur == MOTEUR_ITERATIF) ? MOTEUR_ITERATIF : MOTEUR_MAC;
+    partage.balayage = options->balayage;
+    partage.etages = options->etages;
+    partage.profondeurMax = options->profondeurMax;
+    atomic_init(&partage.arret, false);
+    partage.solution = grille;
+    partage.capacite = 64;
+    partage.taches = malloc(partage.capacite * sizeof(int *));
+    partage.taches[0] = malloc(nbCases * sizeof(int));
+    memcpy(partage.taches[0], grille, nbCases * sizeof(int));
+    partage.nbTaches = 1;
+    pthread_mutex_init(&partage.verrou, NULL);
+    partage.travaux = travaux;
+
+    executerPool(1, options->nbTravailleurs, options->epingler, resoudreSousArbre, &partage);
+
+    pthread_mutex_destroy(&partage.verrou);
+    free(partage.taches);
+    return atomic_load(&partage.arret);
+}
 
-    i = startingRow;
-    while (i < startingRow + n && possible) {
-        j = startingCol;
-        while (j < startingCol + n && possible) {
-            if (grille[i][j].valeur == valeur) {
-                // printf("La valeur %d ne peut pas être placée dans cette région\ncar elle est déjà présente dans la même région\n", valeur);
-                possible = false;
+/**
+ * \fn bool lireEtages(const char *liste, unsigned *etages)
+ * \brief Lit une liste d etages de propagation
+ * \param liste Noms des etages (NOMS_ETAGES) separes par des virgules ou des +,
+ * par exemple "bloques,paires"
+ * \param etages Drapeaux tEtage, auxquels sont ajoutes ceux de la liste
+ * 
+ * \return true si tous les noms sont connus, false sinon
+*/
+bool lireEtages(const char *liste, unsigned *etages) {
+    size_t longueur;
+    bool trouve;
+
+    while (*liste != '\0') {
+        longueur = strcspn(liste, ",+");
+        trouve = false;
+        for (int e = 0; e < NB_ETAGES; e++) {
+            if (strlen(NOMS_ETAGES[e]) == longueur && strncmp(liste, NOMS_ETAGES[e], longueur) == 0) {
+                *etages |= 1u << e;
+                trouve = true;
             }
-            j++;
         }
-        i++;
+        if (!trouve) {
+            return false;
+        }
+        liste += longueur;
+        if (*liste != '\0') {
+            liste++;
+        }
     }
+    return true;
+}
 
-    return possible;
+/**
+ * \fn void nommerStrategie(const tStrategie *strategie, char *nom, size_t taille)
+ * \brief Ecrit le nom d une strategie, tel qu il est lu par lireStrategies
+ * \param strategie Strategie a nommer
+ * \param nom Destination
+ * \param taille Taille de la destination, TAILLE_NOM_STRATEGIE suffit
+*/
+void nommerStrategie(const tStrategie *strategie, char *nom, size_t taille) {
+    size_t longueur;
+
+    snprintf(nom, taille, "%s%s", NOMS_MOTEURS[strategie->moteur], strategie->balayage ? "-balayage" : "");
+    for (int e = 0; e < NB_ETAGES; e++) {
+        longueur = strlen(nom);
+        if ((strategie->etages & (1u << e)) && longueur < taille) {
+            snprintf(nom + longueur, taille - longueur, "+%s", NOMS_ETAGES[e]);
+        }
+    }
 }
 
 /**
- * \fn void initCandidat(candidat_grille grille_candidat)
- * \brief Initialise les candidats de chaque case de la grille.
- * \param grille_candidat Grille de candidats
+ * \fn bool lireStrategies(const char *liste, tOptions *options)
+ * \brief Lit la liste des strategies de --strategies
+ * \param liste Noms des strategies separes par des virgules, par exemple "ligne,mac-balayage"
+ * \param options Options de la ligne de commande, dont les strategies sont remplacees
  * 
- * Cette fonction initialise les candidats de chaque case de la grille
- * en verifiant si chaque valeur est possible dans chaque case.
+ * \return true si tous les noms sont connus, false sinon
+ * 
+ * Un nom est celui d un moteur (ligne, mrv, iteratif, mac), suivi de "-balayage"
+ * pour chercher les singletons par balayage avant la recherche, puis d etages de
+ * propagation precedes chacun de + (par exemple "mac+bloques+paires").
 */
-void initCandidat(candidat_grille grille_candidat) {
-    int num_ligne, num_colonne, valeur_testee;
-    
-    // parcours de la grille
-    for (num_ligne = 0; num_ligne < TAILLE; num_ligne++) {
-        for (num_colonne = 0; num_colonne < TAILLE; num_colonne++) {
-            // check si la case est vide
-            if (grille_candidat[num_ligne][num_colonne].valeur == 0) {
-                // Si oui, on réinitialise le nombre de candidat et on teste toutes les valeurs possibles
-                grille_candidat[num_ligne][num_colonne].nbCandidats = 0;
-                for (valeur_testee = 1; valeur_testee <= TAILLE; valeur_testee++) {
-                    if (possible(grille_candidat, num_ligne, num_colonne, valeur_testee)) {
-                        ajouterCandidat(&grille_candidat[num_ligne][num_colonne], valeur_testee);
-                    }
-                }
+bool lireStrategies(const char *liste, tOptions *options) {
+    char nom[TAILLE_NOM_STRATEGIE];
+    char *etages;
+    size_t longueur;
+    bool trouve;
+
+    options->nbStrategies = 0;
+    while (*liste != '\0') {
+        longueur = strcspn(liste, ",");
+        if (longueur >= sizeof(nom) || options->nbStrategies == NB_STRATEGIES_MAX) {
+            return false;
+        }
+        memcpy(nom, liste, longueur);
+        nom[longueur] = '\0';
+        liste += longueur;
+        if (*liste == ',') {
+            liste++;
+        }
+
+        tStrategie *strategie = &options->strategies[options->nbStrategies];
+        strategie->etages = 0;
+        etages = strchr(nom, '+');
+        if (etages != NULL) {
+            *etages = '\0';
+            if (!lireEtages(etages + 1, &strategie->etages)) {
+                return false;
+            }
+            longueur = strlen(nom);
+        }
+        strategie->balayage = (longueur > 9 && strcmp(nom + longueur - 9, "-balayage") == 0);
+        if (strategie->balayage) {
+            nom[longueur - 9] = '\0';
+        }
+        trouve = false;
+        for (int m = 0; m < NB_MOTEURS; m++) {
+            if (strcmp(nom, NOMS_MOTEURS[m]) == 0) {
+                strategie->moteur = (tMoteur) m;
+                trouve = true;
             }
         }
+        if (!trouve) {
+            return false;
+        }
+        options->nbStrategies++;
     }
+    return options->nbStrategies > 0;
 }
 
 /**
- * \fn void retirerCandidatLigne(candidat_grille grille_candidat, int num_ligne, int valeur)
- * \brief Retire un candidat d une ligne
- * \param grille_candidat Grille de candidats
- * \param num_ligne Numero de la ligne de la case selectionnee
- * \param valeur Valeur a inserer dans la case selectionnee
+ * \fn bool lireVariante(const char *liste, tVariante *variante)
+ * \brief Lit une liste d unites a ajouter aux grilles (--variante)
+ * \param liste "x" pour les deux grandes diagonales, "fenetres" pour les fenetres du
+ * windoku, separes par des virgules ou des +, par exemple "x,fenetres"
+ * \param variante Variante a laquelle sont ajoutees les unites de la liste
  * 
- * Cette fonction retire un candidat d une ligne en verifiant si la valeur
- * est presente dans la ligne de la case selectionnee.
+ * \return true si tous les noms sont connus, false sinon
 */
-void retirerCandidatLigne(candidat_grille grille_candidat, int num_ligne, int valeur) {
-    for (int i = 0; i < TAILLE; i++) {
-        retirerCandidat(&grille_candidat[num_ligne][i], valeur);
+bool lireVariante(const char *liste, tVariante *variante) {
+    size_t longueur;
+
+    while (*liste != '\0') {
+        longueur = strcspn(liste, ",+");
+        if (longueur == 1 && strncmp(liste, "x", 1) == 0) {
+            variante->diagonales = true;
+        } else if (longueur == strlen("fenetres") && strncmp(liste, "fenetres", longueur) == 0) {
+            variante->fenetres = true;
+        } else {
+            return false;
+        }
+        liste += longueur;
+        if (*liste != '\0') {
+            liste++;
+        }
     }
+    return true;
 }
 
 /**
- * \fn void retirerCandidatColonne(candidat_grille grille_candidat, int num_colonne, int valeur)
- * \brief Retire un candidat d une colonne
- * \param grille_candidat Grille de candidats
- * \param num_colonne Numero de la colonne de la case selectionnee
- * \param valeur Valeur a inserer dans la case selectionnee
+ * \fn bool chargerRegions(const char *nom, tVariante *variante)
+ * \brief Lit les regions irregulieres qui remplacent les blocs (--regions)
+ * \param nom Fichier texte contenant une seule grille, dont chaque case est le numero
+ * de sa region, de 1 a TAILLE, dans un format lu par texte.h
+ * \param variante Variante qui recoit les regions et leur taille de bloc
  * 
- * Cette fonction retire un candidat d une colonne en verifiant si la valeur
- * est presente dans la colonne de la case selectionnee.
+ * \return true si le fichier est lisible et forme TAILLE regions de TAILLE cases, false sinon
 */
-void retirerCandidatColonne(candidat_grille grille_candidat, int num_colonne, int valeur) {
-    for (int i = 0; i < TAILLE; i++) {
-        retirerCandidat(&grille_candidat[i][num_colonne], valeur);
+bool chargerRegions(const char *nom, tVariante *variante) {
+    FILE *f = fopen(nom, "rb");
+    char *donnees = NULL;
+    size_t nbOctets = 0;
+    tTexte lu = {0};
+    int nbCases[N_MAX*N_MAX + 1] = {0};
+    int taille, region;
+    bool valide;
+
+    if (f != NULL) {
+        donnees = lireFlux(f, &nbOctets);
+        fclose(f);
+    }
+    valide = donnees != NULL && estTexte(donnees, nbOctets) && lireTexte(donnees, nbOctets, 0, nom, &lu)
+          && lu.nbGrilles == 1;
+    if (valide) {
+        taille = lu.grilles[0].tailleBloc * lu.grilles[0].tailleBloc;
+        free(variante->regions);
+        variante->regions = malloc((size_t) taille*taille);
+        variante->tailleRegions = lu.grilles[0].tailleBloc;
+        valide = (variante->regions != NULL);
+        for (int k = 0; k < taille*taille && valide; k++) {
+            region = lu.cases[lu.grilles[0].debut + k];
+            valide = (region >= 1 && region <= taille && ++nbCases[region] <= taille);
+            variante->regions[k] = (unsigned char) (region - 1);
+        }
     }
+    free(donnees);
+    free(lu.cases);
+    free(lu.grilles);
+    return valide;
 }
 
 /**
- * \fn void retirerCandidatRegion(candidat_grille grille_candidat, int num_ligne, int num_colonne, int valeur)
- * \brief Retire un candidat d une region
- * \param grille_candidat Grille de candidats
- * \param num_ligne Numero de la ligne de la case selectionnee
- * \param num_colonne Numero de la colonne de la case selectionnee
- * \param valeur Valeur a inserer dans la case selectionnee
+ * \fn void courirStrategie(tPool *pool, int numTravailleur, int tache)
+ * \brief Resout la grille de la course avec une strategie, tache executee par un thread du pool
+ * \param pool Pool de threads, dont le contexte est un tCourse
+ * \param numTravailleur Numero du thread
+ * \param tache Rang de la strategie dans options->strategies
  * 
- * Cette fonction retire un candidat d une region en verifiant si la valeur
- * est presente dans la region de la case selectionnee.
+ * La premiere strategie qui repond, qu elle ait trouve la solution ou prouve qu il
+ * n y en a pas, gagne la course et arrete les autres.
 */
-void retirerCandidatRegion(candidat_grille grille_candidat, int num_ligne, int num_colonne, int valeur) {
-    int startingRow = num_ligne - (num_ligne%n);
-    int startingCol = num_colonne - (num_colonne%n);
-
-    for (int i = startingRow; i < startingRow + n; i++) {
-        for (int j = startingCol; j < startingCol + n; j++) {
-            retirerCandidat(&grille_candidat[i][j], valeur);
+void courirStrategie(tPool *pool, int numTravailleur, int tache) {
+    tCourse *course = pool->contexte;
+    tStrategie *strategie = &course->options->strategies[tache];
+    tDonneur donneur = {pool, numTravailleur, &course->arret, 0, NULL};
+    int nbCases = course->tailleBloc*course->tailleBloc*course->tailleBloc*course->tailleBloc;
+    int *cases = malloc(nbCases * sizeof(int));
+    bool attendu = false;
+    bool resolue;
+
+    if (cases == NULL || atomic_load(&course->arret)) {
+        free(cases);
+        return;
+    }
+    memcpy(cases, course->grille, nbCases * sizeof(int));
+    resolue = RESOLUTIONS[course->tailleBloc](cases, strategie->moteur, strategie->balayage, strategie->etages,
+                                              &course->travaux[numTravailleur][course->tailleBloc], &donneur);
+    // une strategie arretee par la gagnante rend false, mais arrive trop tard pour gagner
+    if (atomic_compare_exchange_strong(&course->arret, &attendu, true)) {
+        course->gagnante = tache;
+        course->resolue = resolue;
+        if (resolue) {
+            memcpy(course->solution, cases, nbCases * sizeof(int));
         }
     }
+    free(cases);
 }
 
 /**
- * \fn bool checkSingletonNu(candidat_grille grille_candidat)
- * \brief Verifie si une case a un seul candidat
- * \param grille_candidat Grille de candidats
+ * \fn bool resoudreCourse(int *grille, int tailleBloc, tOptions *options, void *(*travaux)[N_MAX + 1], int *gagnante)
+ * \brief Fait courir les strategies de options sur une grille, chacune dans son thread
+ * \param grille Cases de la grille ligne par ligne, remplacees par la solution
+ * \param tailleBloc Taille d un bloc de la grille
+ * \param options Options de la ligne de commande
+ * \param travaux Etat de resolution de chaque thread, par taille de bloc
+ * \param gagnante Rang de la strategie qui a repondu la premiere
  * 
- * \return true si il y a eu au moins un singleton, false sinon
- * 
- * Cette fonction passe à travers chaque case de la grille de candidats.
- * 
- * Elle verifie si une case a un seul candidat en verifiant
- * si le nombre de candidats de la case est egal a 1.
- * Si c est le cas, la fonction affecte la valeur du candidat a la case
- * et retire le candidat de la liste des candidats de la case.
+ * \return true si la grille est resolue, false si elle n a pas de solution
 */
-bool checkSingletonNu(candidat_grille grille_candidat) {
-    bool action_effectuee = false;
-    for (int i = 0; i < TAILLE; i++) {
-        for (int j = 0; j < TAILLE; j++) {
-            if ((grille_candidat[i][j].valeur == 0) && (nbCandidats(grille_candidat[i][j]) == 1)) {
-                action_effectuee = true;
+bool resoudreCourse(int *grille, int tailleBloc, tOptions *options, void *(*travaux)[N_MAX + 1], int *gagnante) {
+    tCourse course;
+    int nbCases = tailleBloc*tailleBloc*tailleBloc*tailleBloc;
+
+    course.tailleBloc = tailleBloc;
+    course.grille = grille;
+    course.solution = malloc(nbCases * sizeof(int));
+    course.options = options;
+    atomic_init(&course.arret, false);
+    course.gagnante = -1;
+    course.resolue = false;
+    course.travaux = travaux;
+
+    executerPool(options->nbStrategies, options->nbStrategies, options->epingler, courirStrategie, &course);
+
+    if (course.resolue) {
+        memcpy(grille, course.solution, nbCases * sizeof(int));
+    }
+    free(course.solution);
+    *gagnante = course.gagnante;
+    return course.resolue;
+}
 
-                // printf("Singleton nu (%d) trouve dans la case (%d, %d)\n", grille_candidat[i][j].candidats[0], i+1, j+1);
+/**
+ * \fn void resoudreEnsemble(tGrilleLot *grille, tOptions *options, void *(*travaux)[N_MAX + 1])
+ * \brief Resout une grille avec plusieurs threads (--decouper ou --course)
+ * \param grille Grille a resoudre, dont le resultat, le temps reel et la strategie gagnante sont remplis
+ * \param options Options de la ligne de commande
+ * \param travaux Etat de resolution de chaque thread, par taille de bloc
+*/
+void resoudreEnsemble(tGrilleLot *grille, tOptions *options, void *(*travaux)[N_MAX + 1]) {
+    double debut = tempsEcoule();
+    bool resolue;
 
-                grille_candidat[i][j].valeur = grille_candidat[i][j].candidats[0];
-                grille_candidat[i][j].nbCandidats = 0;
+    if (options->course) {
+        resolue = resoudreCourse(grille->cases, grille->tailleBloc, options, travaux, &grille->gagnante);
+    } else {
+        resolue = resoudreDecoupe(grille->cases, grille->tailleBloc, options, travaux);
+    }
+    grille->temps = tempsEcoule() - debut;
+    grille->resultat = resolue ? RESULTAT_RESOLUE : RESULTAT_SANS_SOLUTION;
+}
 
-                retirerCandidatLigne(grille_candidat, i, grille_candidat[i][j].valeur);
-                retirerCandidatColonne(grille_candidat, j, grille_candidat[i][j].valeur);
-                retirerCandidatRegion(grille_candidat, i, j, grille_candidat[i][j].valeur);
-            }
+/*****************************************************
+ *                   BANC D ESSAI                    *
+ *****************************************************/
+
+/**
+ * \fn void echapperJson(const char *texte, char *dest, size_t taille)
+ * \brief Copie un texte en echappant les caracteres interdits dans une chaine JSON
+ * \param texte Texte a copier
+ * \param dest Destination, terminee par un caractere nul
+ * \param taille Taille de dest en octets : le texte est tronque s il ne tient pas
+*/
+void echapperJson(const char *texte, char *dest, size_t taille) {
+    size_t lg = 0;
+
+    for (const unsigned char *c = (const unsigned char *) texte; *c != '\0' && lg + 7 < taille; c++) {
+        if (*c == '"' || *c == '\\') {
+            dest[lg++] = '\\';
+            dest[lg++] = (char) *c;
+        } else if (*c < 0x20) {
+            lg += snprintf(dest + lg, taille - lg, "\\u%04x", *c);
+        } else {
+            dest[lg++] = (char) *c;
         }
     }
-    return action_effectuee;
+    dest[lg] = '\0';
 }
 
 /**
- * \fn void checkSingletonCacheeRegion(candidat_grille grille_candidat, int num_ligne, int num_colonne, bool *action_effectuee)
- * \brief Verifie si une case a un seul candidat dans sa region
- * \param grille_candidat Grille de candidats
- * \param num_ligne Numero de la ligne de la case selectionnee
- * \param num_colonne Numero de la colonne de la case selectionnee
- * \param action_effectuee Pointeur vers un booleen qui indique si une action a ete effectuee
- * \param nb_candidats_elimines Pointeur vers un float qui indique le nombre de candidats elimines
- * \param nb_cases_remplies Pointeur vers un float qui indique le nombre de cases remplies
+ * \fn int comparerDurees(const void *a, const void *b)
+ * \brief Compare deux durees, pour trier les mesures avec qsort
+ * \param a Premiere duree (double)
+ * \param b Deuxieme duree (double)
  * 
- * Cette fonction verifie si une case a un seul candidat dans sa region en verifiant
- * si le nombre de candidats de la case est egal a 1.
- * Si c est le cas, la fonction affecte la valeur du candidat a la case
- * et retire le candidat de la liste des candidats de la case.
+ * \return Un entier negatif, nul ou positif selon que a est plus court, egal ou plus long que b
 */
-void checkSingletonCacheeRegion(candidat_grille grille_candidat, int num_ligne, int num_colonne, bool *action_effectuee) {
-    int startingRow = num_ligne - (num_ligne%n);
-    int startingCol = num_colonne - (num_colonne%n);
-    
-    int nb_occurences[TAILLE] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+int comparerDurees(const void *a, const void *b) {
+    double da = *(const double *) a;
+    double db = *(const double *) b;
+    return (da > db) - (da < db);
+}
 
-    // compte le nombre d occurences de chaque candidat dans la region
-    for (int i = startingRow; i < startingRow+n; i++) {
-        for (int j = startingCol; j < startingCol+n; j++) {
-            for (int k = 0; k < nbCandidats(grille_candidat[i][j]); k++) {
-                nb_occurences[grille_candidat[i][j].candidats[k]-1]++;
-            }
-        }
+/**
+ * \fn double quantile(const double *durees, int nb, double q)
+ * \brief Quantile de durees triees, par la methode du rang le plus proche
+ * \param durees Durees triees par ordre croissant
+ * \param nb Nombre de durees, au moins 1
+ * \param q Ordre du quantile, entre 0 et 1 (0.5 pour la mediane)
+ * 
+ * \return La plus petite duree dont au moins q*nb durees ne sont pas plus longues
+*/
+double quantile(const double *durees, int nb, double q) {
+    int rang = (int) (q * nb + 0.999999);
+    if (rang < 1) {
+        rang = 1;
     }
+    return durees[rang - 1];
+}
 
-    // check si un candidat n apparait qu une seule fois dans la region
-    for (int i = 0; i < TAILLE; i++) {
-        if (nb_occurences[i] == 1) {
-            *action_effectuee = true;
-            // printf("Singleton cachee (%d) trouve dans la region (%d, %d)\n", i+1, num_ligne+1, num_colonne+1);
-            // cherche la case qui contient le candidat
-            for (int j = startingRow; j < startingRow+n; j++) {
-                for (int k = startingCol; k < startingCol+n; k++) {
-                    if (estCandidat(grille_candidat[j][k], i+1)) {
-                        grille_candidat[j][k].valeur = i+1;
-                        grille_candidat[j][k].nbCandidats = 0;
+/**
+ * \fn long memoireMaximale(void)
+ * \brief Memoire maximale occupee par le processus depuis son lancement
+ * 
+ * \return Taille maximale de la memoire residente, en kilooctets (0 si elle est inconnue)
+*/
+long memoireMaximale(void) {
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : 0;
+}
 
-                        retirerCandidatLigne(grille_candidat, j, grille_candidat[j][k].valeur);
-                        retirerCandidatColonne(grille_candidat, k, grille_candidat[j][k].valeur);
-                    }
-                }
-            }
+/**
+ * \fn bool lireChampJson(const char *ligne, const char *champ, char *dest, size_t taille)
+ * \brief Lit la valeur d un champ dans une ligne ecrite par mesurerLot
+ * \param ligne Ligne JSON, terminee par un caractere nul ou un retour a la ligne
+ * \param champ Nom du champ
+ * \param dest Valeur du champ, sans les guillemets d une chaine et sans la desechapper
+ * \param taille Taille de dest en octets
+ * 
+ * \return true si le champ est present et sa valeur tient dans dest
+ * 
+ * Seules les lignes ecrites par le banc d essai sont lues : un objet par ligne,
+ * sans espaces, dont les champs ne contiennent ni objet ni tableau.
+*/
+bool lireChampJson(const char *ligne, const char *champ, char *dest, size_t taille) {
+    char motif[64];
+    const char *debut, *fin;
+
+    snprintf(motif, sizeof(motif), "\"%s\":", champ);
+    debut = strstr(ligne, motif);
+    if (debut == NULL) {
+        return false;
+    }
+    debut += strlen(motif);
+    if (*debut == '"') {
+        debut++;
+        fin = debut;
+        while (*fin != '"' && *fin != '\0' && *fin != '\n') {
+            fin += (*fin == '\\' && fin[1] != '\0') ? 2 : 1;
         }
+    } else {
+        fin = debut + strcspn(debut, ",}\n");
     }
+    if ((size_t)(fin - debut) >= taille) {
+        return false;
+    }
+    memcpy(dest, debut, fin - debut);
+    dest[fin - debut] = '\0';
+    return true;
 }
 
 /**
- * \fn void checkSingletonCacheeLigne(candidat_grille grille_candidat, int num_ligne, bool *action_effectuee)
- * \brief Verifie si une case a un seul candidat dans sa ligne
- * \param grille_candidat Grille de candidats
- * \param num_ligne Numero de la ligne de la case selectionnee
- * \param action_effectuee Pointeur vers un booleen qui indique si une action a ete effectuee
- * \param nb_candidats_elimines Pointeur vers un float qui indique le nombre de candidats elimines
- * \param nb_cases_remplies Pointeur vers un float qui indique le nombre de cases remplies
+ * \fn tReference *lireReference(const char *nom, int *nbReferences)
+ * \brief Lit les medianes d une execution precedente du banc d essai
+ * \param nom Fichier ecrit par --banc (une ligne JSON par mesure)
+ * \param nbReferences Nombre de mesures lues
  * 
- * Cette fonction verifie si une case a un seul candidat dans sa ligne en verifiant
- * si le nombre de candidats de la case est egal a 1.
- * Si c est le cas, la fonction affecte la valeur du candidat a la case
- * et retire le candidat de la liste des candidats de la case.
+ * \return Tableau des mesures, a liberer avec leurs cles, ou NULL si le fichier est illisible
 */
-void checkSingletonCacheeLigne(candidat_grille grille_candidat, int num_ligne, bool *action_effectuee) {
-    int nb_occurences[TAILLE] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-
-    // compte le nombre d occurences de chaque candidat dans la ligne
-    for (int i = 0; i < TAILLE; i++) {
-        for (int j = 0; j < nbCandidats(grille_candidat[num_ligne][i]); j++) {
-            nb_occurences[grille_candidat[num_ligne][i].candidats[j]-1]++;
-        }
+tReference *lireReference(const char *nom, int *nbReferences) {
+    FILE *f = fopen(nom, "rb");
+    tReference *references = NULL;
+    tReference *nouveau;
+    char grille[1024], strategie[TAILLE_NOM_STRATEGIE], mediane[64];
+    char *contenu, *ligne, *suivante;
+    size_t taille;
+
+    *nbReferences = 0;
+    if (f == NULL) {
+        return NULL;
     }
-
-    // check si un candidat n apparait qu une seule fois dans la ligne
-    for (int i = 0; i < TAILLE; i++) {
-        if (nb_occurences[i] == 1) {
-            *action_effectuee = true;
-            // printf("Singleton cachee (%d) trouvee dans la ligne %d\n", i+1, num_ligne+1);
-            // cherche la case qui contient le candidat
-            for (int j = 0; j < TAILLE; j++) {
-                if (estCandidat(grille_candidat[num_ligne][j], i+1)) {
-                    grille_candidat[num_ligne][j].valeur = i+1;
-                    grille_candidat[num_ligne][j].nbCandidats = 0;
-
-                    retirerCandidatColonne(grille_candidat, j, grille_candidat[num_ligne][j].valeur);
-                    retirerCandidatRegion(grille_candidat, num_ligne, j, grille_candidat[num_ligne][j].valeur);
-                }
+    contenu = lireFlux(f, &taille);
+    fclose(f);
+    if (contenu == NULL) {
+        return NULL;
+    }
+    // lireFlux laisse toujours au moins un octet libre apres le contenu
+    contenu[taille] = '\0';
+
+    references = malloc(sizeof(tReference));
+    for (ligne = contenu; ligne != NULL && *ligne != '\0' && references != NULL; ligne = suivante) {
+        suivante = strchr(ligne, '\n');
+        if (suivante != NULL) {
+            suivante++;
+        }
+        if (lireChampJson(ligne, "grille", grille, sizeof(grille))
+            && lireChampJson(ligne, "strategie", strategie, sizeof(strategie))
+            && lireChampJson(ligne, "mediane_s", mediane, sizeof(mediane))) {
+            nouveau = realloc(references, (*nbReferences + 1) * sizeof(tReference));
+            if (nouveau == NULL) {
+                break;
             }
+            references = nouveau;
+            references[*nbReferences].cle = malloc(strlen(grille) + strlen(strategie) + 2);
+            sprintf(references[*nbReferences].cle, "%s\t%s", grille, strategie);
+            references[*nbReferences].mediane = strtod(mediane, NULL);
+            (*nbReferences)++;
         }
     }
+    free(contenu);
+    return references;
 }
 
 /**
- * \fn void checkSingletonCacheeColonne(candidat_grille grille_candidat, int num_colonne, bool *action_effectuee)
- * \brief Verifie si une case a un seul candidat dans sa colonne
- * \param grille_candidat Grille de candidats
- * \param num_colonne Numero de la colonne de la case selectionnee
- * \param action_effectuee Pointeur vers un booleen qui indique si une action a ete effectuee
- * \param nb_candidats_elimines Pointeur vers un float qui indique le nombre de candidats elimines
- * \param nb_cases_remplies Pointeur vers un float qui indique le nombre de cases remplies
+ * \fn int mesurerLot(tLot *lot, tOptions *options, FILE *sortie)
+ * \brief Mesure le temps de resolution de chaque grille du lot par chaque strategie (--banc)
+ * \param lot Lot de grilles
+ * \param options Options de la ligne de commande : strategies, echauffement, repetitions,
+ * reference et seuil
+ * \param sortie Flux ou ecrire les mesures
  * 
- * Cette fonction verifie si une case a un seul candidat dans sa colonne en verifiant
- * si le nombre de candidats de la case est egal a 1.
- * Si c est le cas, la fonction affecte la valeur du candidat a la case
- * et retire le candidat de la liste des candidats de la case.
+ * \return Nombre de mesures plus lentes que la reference, -1 si la reference est illisible
+ * 
+ * Chaque strategie resout chaque grille options->echauffement fois sans mesure, pour
+ * remplir les caches et allouer l etat de resolution, puis options->repetitions fois.
+ * Chaque resolution part d une copie de la grille et est chronometree avec l horloge
+ * monotone (tempsEcoule) : seul l appel au noyau est mesure.
+ * Chaque mesure est ecrite sur une ligne JSON : duree minimale, mediane et 99e centile
+ * en secondes, nombre de noeuds de la recherche (identique a chaque repetition) et
+ * noeuds par seconde a la mediane, et memoire maximale du processus.
+ * Avec une reference, la mediane est comparee a celle de la meme grille et de la meme
+ * strategie : au-dela de options->seuil pour cent de plus, la mesure est signalee.
 */
-void checkSingletonCacheeColonne(candidat_grille grille_candidat, int num_colonne, bool *action_effectuee) {
-    int nb_occurences[TAILLE] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-
-    // compte le nombre d occurences de chaque candidat dans la colonne
-    for (int i = 0; i < TAILLE; i++) {
-        for (int j = 0; j < nbCandidats(grille_candidat[i][num_colonne]); j++) {
-            nb_occurences[grille_candidat[i][num_colonne].candidats[j]-1]++;
+int mesurerLot(tLot *lot, tOptions *options, FILE *sortie) {
+    void *travaux[N_MAX + 1] = {NULL};
+    double *durees = malloc(options->repetitions * sizeof(double));
+    int *essai = malloc((size_t)N_MAX*N_MAX*N_MAX*N_MAX * sizeof(int));
+    tReference *references = NULL;
+    int nbReferences = 0;
+    int nbRalentis = 0;
+    char nom[1024], grilleJson[1024], strategie[TAILLE_NOM_STRATEGIE], cle[1024 + TAILLE_NOM_STRATEGIE];
+    double debut, minimum, mediane, p99, ecart;
+    long noeuds;
+    bool resolue = false;
+
+    if (options->nomReference != NULL) {
+        references = lireReference(options->nomReference, &nbReferences);
+        if (references == NULL) {
+            fprintf(stderr, "ERREUR. Impossible de lire les mesures de reference \'%s\'.\n", options->nomReference);
+            free(durees);
+            free(essai);
+            return -1;
         }
     }
 
-    // check si un candidat n apparait qu une seule fois dans la colonne
-    for (int i = 0; i < TAILLE; i++) {
-        if (nb_occurences[i] == 1) {
-            *action_effectuee = true;
-            // printf("Singleton cachee (%d) trouvee dans la colonne %d\n", i+1, num_colonne+1);
-            // cherche la case qui contient le candidat
-            for (int j = 0; j < TAILLE; j++) {
-                if (estCandidat(grille_candidat[j][num_colonne], i+1)) {
-                    grille_candidat[j][num_colonne].valeur = i+1;
-                    grille_candidat[j][num_colonne].nbCandidats = 0;
+    for (int i = 0; i < lot->nbGrilles; i++) {
+        tGrilleLot *grille = &lot->grilles[i];
+        int nbCases = grille->tailleBloc*grille->tailleBloc*grille->tailleBloc*grille->tailleBloc;
+
+        snprintf(nom, sizeof(nom), "%s:%d", lot->fichiers[grille->numFichier].nom, grille->indice);
+        echapperJson(nom, grilleJson, sizeof(grilleJson));
+        if (!preparerCases(grille) || !grilleValide(grille->cases, grille->tailleBloc)) {
+            fprintf(sortie, "{\"grille\":\"%s\",\"resultat\":\"invalide\"}\n", grilleJson);
+            relacherCases(grille, options);
+            continue;
+        }
 
-                    retirerCandidatLigne(grille_candidat, j, grille_candidat[j][num_colonne].valeur);
-                    retirerCandidatRegion(grille_candidat, j, num_colonne, grille_candidat[j][num_colonne].valeur);
+        for (int s = 0; s < options->nbStrategies; s++) {
+            tStrategie *choisie = &options->strategies[s];
+
+            nommerStrategie(choisie, strategie, sizeof(strategie));
+            for (int r = 0; r < options->echauffement + options->repetitions; r++) {
+                memcpy(essai, grille->cases, nbCases * sizeof(int));
+                debut = tempsEcoule();
+                resolue = RESOLUTIONS[grille->tailleBloc](essai, choisie->moteur, choisie->balayage, choisie->etages,
+                                                          &travaux[grille->tailleBloc], NULL);
+                if (r >= options->echauffement) {
+                    durees[r - options->echauffement] = tempsEcoule() - debut;
+                }
+            }
+            qsort(durees, options->repetitions, sizeof(double), comparerDurees);
+            minimum = durees[0];
+            mediane = quantile(durees, options->repetitions, 0.5);
+            p99 = quantile(durees, options->repetitions, 0.99);
+            noeuds = NOEUDS[grille->tailleBloc](travaux[grille->tailleBloc]);
+
+            fprintf(sortie, "{\"grille\":\"%s\",\"n\":%d,\"strategie\":\"%s\",\"resultat\":\"%s\","
+                            "\"repetitions\":%d,\"min_s\":%.9f,\"mediane_s\":%.9f,\"p99_s\":%.9f,"
+                            "\"noeuds\":%ld,\"noeuds_par_s\":%.0f,\"memoire_max_ko\":%ld",
+                    grilleJson, grille->tailleBloc, strategie, resolue ? "resolue" : "sans_solution",
+                    options->repetitions, minimum, mediane, p99,
+                    noeuds, mediane > 0 ? noeuds / mediane : 0.0, memoireMaximale());
+
+            snprintf(cle, sizeof(cle), "%s\t%s", grilleJson, strategie);
+            for (int k = 0; k < nbReferences; k++) {
+                if (strcmp(references[k].cle, cle) == 0 && references[k].mediane > 0) {
+                    ecart = 100.0 * (mediane / references[k].mediane - 1.0);
+                    fprintf(sortie, ",\"reference_mediane_s\":%.9f,\"ecart_pct\":%.1f,\"ralenti\":%s",
+                            references[k].mediane, ecart, ecart > options->seuil ? "true" : "false");
+                    if (ecart > options->seuil) {
+                        fprintf(stderr, "RALENTISSEMENT. %s %s : mediane de %.6f s au lieu de %.6f s (%+.1f %%)\n",
+                                nom, strategie, mediane, references[k].mediane, ecart);
+                        nbRalentis++;
+                    }
                     break;
                 }
             }
+            fprintf(sortie, "}\n");
+            fflush(sortie);
         }
+        relacherCases(grille, options);
     }
-}
 
-/**
- * \fn bool checkSingletonCachee(candidat_grille grille_candidat)
- * \brief Verifie si une case a un seul candidat dans sa ligne, colonne ou region
- * \param grille_candidat Grille de candidats
- * \param nb_candidats_elimines Pointeur vers un float qui indique le nombre de candidats elimines
- * \param nb_cases_remplies Pointeur vers un float qui indique le nombre de cases remplies
- * 
- * \return true si il y a eu au moins un singleton cachee, false sinon
-*/
-bool checkSingletonCachee(candidat_grille grille_candidat) {
-    bool action_effectuee = false;
-
-    for (int i = 0; i < TAILLE; i++) {
-        checkSingletonCacheeLigne(grille_candidat, i, &action_effectuee);
+    for (int k = 0; k < nbReferences; k++) {
+        free(references[k].cle);
     }
-    for (int i = 0; i < TAILLE; i++) {
-        checkSingletonCacheeColonne(grille_candidat, i, &action_effectuee);
+    free(references);
+    for (int k = 0; k <= N_MAX; k++) {
+        free(travaux[k]);
     }
-    // check regions
-    for (int i = 0; i < TAILLE; i+=n) {
-        for (int j = 0; j < TAILLE; j+=n) {
-            checkSingletonCacheeRegion(grille_candidat, i, j, &action_effectuee);
-        }
-    }
-    return action_effectuee;
+    free(essai);
+    free(durees);
+    return nbRalentis;
 }
 
 /*****************************************************
@@ -757,20 +2886,24 @@ bool checkSingletonCachee(candidat_grille grille_candidat) {
  *****************************************************/
 
 /**
- * \fn void chargerGrille(tGrille grille)
+ * \fn int *chargerGrille(int *tailleBloc)
  * \brief Charge une grille de jeu a partir d un fichier
- * \param grille Grille de jeu a initialiser
+ * \param tailleBloc Taille de bloc de la grille : si elle vaut 0, elle est deduite
+ * de la taille du fichier (n*n*n*n entiers) et renvoyee dans ce parametre
  * 
- * \return Le charactere correspondant au numero de la grille
+ * \return Les cases de la grille ligne par ligne, allouees dynamiquement
  * La fonction charge une grille de jeu a partir d un fichier
  * dont le nom est saisi au clavier.
  * Cette fonction arrete le programme avec le code de sortie 1 
- * si le dossier 'grilles/' n est pas present ou si le fichier n est pas trouve
+ * si le dossier 'grilles/' n est pas present, si le fichier n est pas trouve
+ * ou si sa taille ne correspond a aucune taille de bloc geree
 */
-char chargerGrille(tGrille grille){
+int *chargerGrille(int *tailleBloc){
     FILE * f;
     char nomFichier[30];  // chaine de caracteres contenant le nom du fichier de grille a initialiser
     char numFic;  // le numero du fichier de grille a initialiser */
+    long nbCases;
+    int *grille = NULL;
 
     // test si le dossier ./grilles est present
     if (access("./grilles", 0) == 0) {
@@ -789,7 +2922,19 @@ char chargerGrille(tGrille grille){
             printf("\tet qu'il contienne les fichier \'MaxiGrille_.sud\', où \'_\' est un nombre entre de 1 à 10.\n");
             exit(EXIT_FAILURE);
         } else {
-            fread(grille, sizeof(int), TAILLE*TAILLE, f);
+            // le fichier contient TAILLE*TAILLE entiers, soit n^4
+            fseek(f, 0, SEEK_END);
+            nbCases = ftell(f) / (long)sizeof(int);
+            fseek(f, 0, SEEK_SET);
+            if (*tailleBloc == 0) {
+                *tailleBloc = tailleBlocDepuisNbCases(nbCases);
+            }
+            if (*tailleBloc == 0 || nbCases != (long)(*tailleBloc)*(*tailleBloc)*(*tailleBloc)*(*tailleBloc)) {
+                printf("ERREUR. Le fichier \'%s\' ne contient pas une grille de taille geree.\n", nomFichier);
+                exit(EXIT_FAILURE);
+            }
+            grille = malloc(nbCases * sizeof(int));
+            fread(grille, sizeof(int), nbCases, f);
         }
         fclose(f);
     } 
@@ -799,7 +2944,7 @@ char chargerGrille(tGrille grille){
         printf("\tet qu'il contienne les fichier \'MaxiGrille_.sud\', où \'_\' est un nombre entre de 1 à 10.\n");
         exit(EXIT_FAILURE);
     }
-    return numFic;
+    return grille;
 }
 
 /**
@@ -822,97 +2967,103 @@ int nombreChiffre(int nombre) {
 }
 
 /**
- * \fn void afficherEspaces(int nombre_espaces)
+ * \fn void afficherEspaces(FILE *sortie, int nombre_espaces)
  * \brief Affiche un nombre d espaces
+ * \param sortie Flux ou afficher
  * \param nombre_espaces Nombre d espaces a afficher
 */
-void afficherEspaces(int nombre_espaces) {
+void afficherEspaces(FILE *sortie, int nombre_espaces) {
     for (int i=0; i < nombre_espaces; i++) {
-        printf(" ");
+        fprintf(sortie, " ");
     }
 }
 
 /**
- * \fn void afficherLigneSeparatrice(nombre_espaces)
+ * \fn void afficherLigneSeparatrice(FILE *sortie, int nombre_espaces, int tailleBloc)
  * \brief Affiche une ligne separatrice
+ * \param sortie Flux ou afficher
  * \param nombre_espaces Nombre d espaces a afficher
+ * \param tailleBloc Taille d un bloc de la grille
  * 
  * Affiche une ligne separatrice dont la taille est adaptative en fonction de la taille de la grille.
  * Taille minimum de la grille : 1
 */
-void afficherLigneSeparatrice(int nombre_espaces) {
-    afficherEspaces(nombre_espaces);
-    for (int i=0; i < n; i++) {
-        printf("+----");
-        for (int j=0; j < n-1; j++) {
-            printf("---");
+void afficherLigneSeparatrice(FILE *sortie, int nombre_espaces, int tailleBloc) {
+    afficherEspaces(sortie, nombre_espaces);
+    for (int i=0; i < tailleBloc; i++) {
+        fprintf(sortie, "+----");
+        for (int j=0; j < tailleBloc-1; j++) {
+            fprintf(sortie, "---");
         }
     }
-    printf("+\n");
+    fprintf(sortie, "+\n");
 }
 
 /**
- * \fn void afficherGrille(candidat grille_candidat)
- * \brief Affiche la grille de jeu de maniere lisible en fonction de TAILLE
- * \param grille_candidat Grille de jeu a afficher
+ * \fn void afficherGrille(FILE *sortie, int *grille, int tailleBloc)
+ * \brief Affiche la grille de jeu de maniere lisible en fonction de sa taille
+ * \param sortie Flux ou afficher
+ * \param grille Cases de la grille ligne par ligne
+ * \param tailleBloc Taille d un bloc de la grille
  * 
  * Cette fonction affiche la grille de jeu de maniere lisible en
  * affichant les numeros des lignes et des colonnes, ainsi que les
  * lignes et colonnes de separation entre les blocs de la grille.
  * Les cellules vides sont representees par un point.
- * La taille de la grille est adaptee en fonction de TAILLE.
+ * La taille de la grille est adaptee en fonction de tailleBloc.
 */
-void afficherGrille(candidat_grille grille_candidat) {
+void afficherGrille(FILE *sortie, int *grille, int tailleBloc) {
     int i, j, num_espaces; 
+    int taille = tailleBloc*tailleBloc;
 
-    printf("\n");
+    fprintf(sortie, "\n");
 
     // determine le nombre de chiffres dans le nombre le plus grand de la grille
-    num_espaces = nombreChiffre(TAILLE) + 1; /** \var nombre d espaces avant le debut de la grille */
+    num_espaces = nombreChiffre(taille) + 1; /** \var nombre d espaces avant le debut de la grille */
 
     // numeros des colonnes
-    afficherEspaces(num_espaces+1);
-    for (i = 0; i < TAILLE; i++) {
+    afficherEspaces(sortie, num_espaces+1);
+    for (i = 0; i < taille; i++) {
         // check si i a atteint la fin d une region
-        if ((i%n == 0) && (i != 0)){
-            printf("  ");
+        if ((i%tailleBloc == 0) && (i != 0)){
+            fprintf(sortie, "  ");
         }
-        printf("%3d", i+1);
+        fprintf(sortie, "%3d", i+1);
     }
-    printf("\n");
+    fprintf(sortie, "\n");
 
     //affichage de la premiere ligne de separation
-    afficherLigneSeparatrice(num_espaces);
+    afficherLigneSeparatrice(sortie, num_espaces, tailleBloc);
 
 
     // corps de la grille + cote gauche
-    for (i=0; i < TAILLE; i++) {
+    for (i=0; i < taille; i++) {
         //check si i a atteint la fin d une region
-        if ((i%n == 0) && (i != 0)){
-            afficherLigneSeparatrice(num_espaces);
+        if ((i%tailleBloc == 0) && (i != 0)){
+            afficherLigneSeparatrice(sortie, num_espaces, tailleBloc);
         }
 
         // numeros des lignes
-        printf("%d", i+1);
-        afficherEspaces(num_espaces - nombreChiffre(i+1));
-        printf("%c", '|');
+        fprintf(sortie, "%d", i+1);
+        afficherEspaces(sortie, num_espaces - nombreChiffre(i+1));
+        fprintf(sortie, "%c", '|');
 
-        for (j=0; j < TAILLE; j++) {
+        for (j=0; j < taille; j++) {
             // check si j a atteint la fin d une region
-            if ((j%n == 0) && (j != 0)){
-                printf("%2c",  '|' );
+            if ((j%tailleBloc == 0) && (j != 0)){
+                fprintf(sortie, "%2c",  '|' );
             }
 
             // affiche '.' au lieu de 0 pour les cellules vides
-            if (grille_candidat[i][j].valeur == 0) {
-                printf("%3c", CELLULE_VIDE);
+            if (grille[i*taille + j] == 0) {
+                fprintf(sortie, "%3c", CELLULE_VIDE);
             } else {
-                printf("%3d", grille_candidat[i][j].valeur);
+                fprintf(sortie, "%3d", grille[i*taille + j]);
             }
         }
-        printf("%2c",  '|' );
-        printf("\n");
+        fprintf(sortie, "%2c",  '|' );
+        fprintf(sortie, "\n");
     }
     // derniere ligne
-    afficherLigneSeparatrice(num_espaces);
+    afficherLigneSeparatrice(sortie, num_espaces, tailleBloc);
 }
\ No newline at end of file
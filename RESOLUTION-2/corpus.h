@@ -0,0 +1,266 @@
+/**
+ * \file corpus.h
+ * \brief Format compact de corpus de grilles, lisible par projection en memoire (mmap)
+ * \author PFRANGER Matheo, FAUCHET Malo
+ * \date 16 Octobre 2026
+ * \version 1.0
+ *
+ * Un fichier .sudc contient toutes les grilles d une meme taille de bloc n :
+ * - un en-tete de TAILLE_ENTETE_CORPUS octets :
+ *   | octets | contenu                                             |
+ *   |--------|-----------------------------------------------------|
+ *   | 0-3    | "SUDC"                                              |
+ *   | 4-5    | version (VERSION_CORPUS)                            |
+ *   | 6      | taille de bloc n                                    |
+ *   | 7      | nombre de bits par case                             |
+ *   | 8-11   | drapeaux (aucun n est defini, ils doivent valoir 0) |
+ *   | 12-15  | reserve, 0                                          |
+ *   | 16-23  | nombre de grilles                                   |
+ *   | 24-31  | position de l index dans le fichier                 |
+ * - l index : pour chaque grille, la position (8 octets) de ses cases dans le fichier
+ * - les cases de chaque grille, ligne par ligne, sur bitsParCase(n) bits chacune
+ *   (5 bits pour une grille 16x16), les bits de poids faible en premier.
+ * Tous les entiers sont ecrits en petit-boutiste, quel que soit le processeur.
+ *
+ * Inclus par RESOLUTION-2.c.
+*/
+
+#include <stdint.h>
+
+/**
+ * \def MAGIE_CORPUS
+ * \brief Premiers octets d un fichier de corpus
+*/
+#define MAGIE_CORPUS "SUDC"
+
+/**
+ * \def VERSION_CORPUS
+ * \brief Version du format ecrit par ecrireCorpus
+*/
+#define VERSION_CORPUS 1
+
+/**
+ * \def TAILLE_ENTETE_CORPUS
+ * \brief Taille de l en-tete d un fichier de corpus, en octets
+*/
+#define TAILLE_ENTETE_CORPUS 32
+
+/**
+ * \struct tEnteteCorpus
+ * \brief En-tete d un fichier de corpus, une fois lu
+*/
+typedef struct {
+    int version;
+    int tailleBloc;
+    int bitsParCase;
+    uint32_t drapeaux;
+    uint64_t nbGrilles;
+    uint64_t debutIndex;
+} tEnteteCorpus;
+
+// Corpus functions
+int bitsParCase(int tailleBloc);
+size_t tailleGrilleCompactee(int tailleBloc);
+uint64_t lireEntier(const unsigned char *octets, int nbOctets);
+void ecrireEntier(unsigned char *octets, uint64_t valeur, int nbOctets);
+void compacterGrille(const int *cases, int tailleBloc, unsigned char *compacte);
+void decompacterGrille(const unsigned char *compacte, int tailleBloc, int bits, int *cases);
+const unsigned char *grilleCorpus(const unsigned char *donnees, tEnteteCorpus *entete, uint64_t numGrille);
+bool lireEnteteCorpus(const unsigned char *donnees, size_t taille, tEnteteCorpus *entete);
+bool ecrireCorpus(FILE *f, int tailleBloc, int **grilles, long nbGrilles);
+
+/**
+ * \fn int bitsParCase(int tailleBloc)
+ * \brief Nombre de bits necessaires pour une case (valeurs 0 a TAILLE)
+ * \param tailleBloc Taille d un bloc de la grille
+ *
+ * \return Nombre de bits d une case compactee
+*/
+int bitsParCase(int tailleBloc) {
+    int bits = 1;
+    while ((1 << bits) <= tailleBloc*tailleBloc) {
+        bits++;
+    }
+    return bits;
+}
+
+/**
+ * \fn size_t tailleGrilleCompactee(int tailleBloc)
+ * \brief Nombre d octets occupes par les cases compactees d une grille
+ * \param tailleBloc Taille d un bloc de la grille
+ *
+ * \return Taille en octets, arrondie a l octet superieur
+*/
+size_t tailleGrilleCompactee(int tailleBloc) {
+    size_t nbCases = (size_t)tailleBloc*tailleBloc*tailleBloc*tailleBloc;
+    return (nbCases * bitsParCase(tailleBloc) + 7) / 8;
+}
+
+/**
+ * \fn uint64_t lireEntier(const unsigned char *octets, int nbOctets)
+ * \brief Lit un entier petit-boutiste
+ * \param octets Premier octet de l entier
+ * \param nbOctets Taille de l entier en octets
+ *
+ * \return Valeur de l entier
+*/
+uint64_t lireEntier(const unsigned char *octets, int nbOctets) {
+    uint64_t valeur = 0;
+    for (int i = nbOctets - 1; i >= 0; i--) {
+        valeur = (valeur << 8) | octets[i];
+    }
+    return valeur;
+}
+
+/**
+ * \fn void ecrireEntier(unsigned char *octets, uint64_t valeur, int nbOctets)
+ * \brief Ecrit un entier en petit-boutiste
+ * \param octets Premier octet ou ecrire l entier
+ * \param valeur Valeur de l entier
+ * \param nbOctets Taille de l entier en octets
+*/
+void ecrireEntier(unsigned char *octets, uint64_t valeur, int nbOctets) {
+    for (int i = 0; i < nbOctets; i++) {
+        octets[i] = (unsigned char) (valeur >> (8*i));
+    }
+}
+
+/**
+ * \fn void compacterGrille(const int *cases, int tailleBloc, unsigned char *compacte)
+ * \brief Compacte les cases d une grille sur bitsParCase(tailleBloc) bits chacune
+ * \param cases Cases de la grille ligne par ligne, entre 0 et TAILLE
+ * \param tailleBloc Taille d un bloc de la grille
+ * \param compacte Destination, de tailleGrilleCompactee(tailleBloc) octets
+*/
+void compacterGrille(const int *cases, int tailleBloc, unsigned char *compacte) {
+    int bits = bitsParCase(tailleBloc);
+    int nbCases = tailleBloc*tailleBloc*tailleBloc*tailleBloc;
+    size_t position;
+
+    memset(compacte, 0, tailleGrilleCompactee(tailleBloc));
+    for (int i = 0; i < nbCases; i++) {
+        position = (size_t)i * bits;
+        unsigned int valeur = (unsigned int) cases[i] << (position % 8);
+        compacte[position / 8] |= (unsigned char) valeur;
+        if ((position % 8) + bits > 8) {
+            compacte[position / 8 + 1] |= (unsigned char) (valeur >> 8);
+        }
+    }
+}
+
+/**
+ * \fn void decompacterGrille(const unsigned char *compacte, int tailleBloc, int bits, int *cases)
+ * \brief Retrouve les cases d une grille compactee par compacterGrille
+ * \param compacte Cases compactees, par exemple dans un corpus projete en memoire
+ * \param tailleBloc Taille d un bloc de la grille
+ * \param bits Nombre de bits par case : bitsParCase(tailleBloc) dans un corpus,
+ * 8 pour les cases d un octet lues dans un texte
+ * \param cases Destination, TAILLE*TAILLE entiers
+ *
+ * Une case fait au plus 8 bits, elle tient donc dans deux octets consecutifs.
+*/
+void decompacterGrille(const unsigned char *compacte, int tailleBloc, int bits, int *cases) {
+    int nbCases = tailleBloc*tailleBloc*tailleBloc*tailleBloc;
+    unsigned int masque = (1u << bits) - 1;
+    unsigned int fenetre;
+    size_t position;
+
+    for (int i = 0; i < nbCases; i++) {
+        position = (size_t)i * bits;
+        fenetre = compacte[position / 8];
+        if ((position % 8) + bits > 8) {
+            fenetre |= (unsigned int) compacte[position / 8 + 1] << 8;
+        }
+        cases[i] = (int) ((fenetre >> (position % 8)) & masque);
+    }
+}
+
+/**
+ * \fn const unsigned char *grilleCorpus(const unsigned char *donnees, tEnteteCorpus *entete, uint64_t numGrille)
+ * \brief Donne l adresse des cases compactees d une grille du corpus
+ * \param donnees Contenu du fichier de corpus
+ * \param entete En-tete lu par lireEnteteCorpus
+ * \param numGrille Rang de la grille, a partir de 0
+ *
+ * \return Adresse des cases de la grille dans donnees
+*/
+const unsigned char *grilleCorpus(const unsigned char *donnees, tEnteteCorpus *entete, uint64_t numGrille) {
+    return donnees + lireEntier(donnees + entete->debutIndex + 8*numGrille, 8);
+}
+
+/**
+ * \fn bool lireEnteteCorpus(const unsigned char *donnees, size_t taille, tEnteteCorpus *entete)
+ * \brief Lit et verifie l en-tete et l index d un corpus
+ * \param donnees Contenu du fichier de corpus
+ * \param taille Taille du fichier en octets
+ * \param entete En-tete lu
+ *
+ * \return true si le fichier est un corpus valide : en-tete connu, taille de bloc geree,
+ * et index et grilles entierement contenus dans le fichier
+*/
+bool lireEnteteCorpus(const unsigned char *donnees, size_t taille, tEnteteCorpus *entete) {
+    uint64_t position;
+
+    if (taille < TAILLE_ENTETE_CORPUS || memcmp(donnees, MAGIE_CORPUS, 4) != 0) {
+        return false;
+    }
+    entete->version = (int) lireEntier(donnees + 4, 2);
+    entete->tailleBloc = donnees[6];
+    entete->bitsParCase = donnees[7];
+    entete->drapeaux = (uint32_t) lireEntier(donnees + 8, 4);
+    entete->nbGrilles = lireEntier(donnees + 16, 8);
+    entete->debutIndex = lireEntier(donnees + 24, 8);
+
+    if (entete->version != VERSION_CORPUS || entete->drapeaux != 0
+        || entete->tailleBloc < N_MIN || entete->tailleBloc > N_MAX
+        || entete->bitsParCase != bitsParCase(entete->tailleBloc)
+        || entete->debutIndex > taille || entete->nbGrilles > (taille - entete->debutIndex) / 8) {
+        return false;
+    }
+    for (uint64_t i = 0; i < entete->nbGrilles; i++) {
+        position = lireEntier(donnees + entete->debutIndex + 8*i, 8);
+        if (position > taille || taille - position < tailleGrilleCompactee(entete->tailleBloc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn bool ecrireCorpus(FILE *f, int tailleBloc, int **grilles, long nbGrilles)
+ * \brief Ecrit un corpus de grilles de meme taille
+ * \param f Fichier ouvert en ecriture binaire
+ * \param tailleBloc Taille d un bloc des grilles
+ * \param grilles Cases de chaque grille, ligne par ligne, entre 0 et TAILLE
+ * \param nbGrilles Nombre de grilles
+ *
+ * \return true si le corpus est ecrit, false en cas d erreur d ecriture
+ *
+ * L index suit l en-tete, et les grilles suivent l index dans l ordre.
+*/
+bool ecrireCorpus(FILE *f, int tailleBloc, int **grilles, long nbGrilles) {
+    unsigned char entete[TAILLE_ENTETE_CORPUS] = {0};
+    unsigned char position[8];
+    size_t tailleGrille = tailleGrilleCompactee(tailleBloc);
+    unsigned char *compacte = malloc(tailleGrille);
+    bool ecrit = (compacte != NULL);
+
+    memcpy(entete, MAGIE_CORPUS, 4);
+    ecrireEntier(entete + 4, VERSION_CORPUS, 2);
+    entete[6] = (unsigned char) tailleBloc;
+    entete[7] = (unsigned char) bitsParCase(tailleBloc);
+    ecrireEntier(entete + 16, (uint64_t) nbGrilles, 8);
+    ecrireEntier(entete + 24, TAILLE_ENTETE_CORPUS, 8);
+    ecrit = ecrit && fwrite(entete, 1, sizeof(entete), f) == sizeof(entete);
+
+    for (long i = 0; i < nbGrilles && ecrit; i++) {
+        ecrireEntier(position, TAILLE_ENTETE_CORPUS + 8*(uint64_t)nbGrilles + i*(uint64_t)tailleGrille, 8);
+        ecrit = fwrite(position, 1, 8, f) == 8;
+    }
+    for (long i = 0; i < nbGrilles && ecrit; i++) {
+        compacterGrille(grilles[i], tailleBloc, compacte);
+        ecrit = fwrite(compacte, 1, tailleGrille, f) == tailleGrille;
+    }
+    free(compacte);
+    return ecrit;
+}
\ No newline at end of file
@@ -0,0 +1,3257 @@
+/**
+ * \file noyau.h
+ * \brief Noyau de resolution specialise pour une taille de bloc
+ * \author PFRANGER Matheo, FAUCHET Malo
+ * \date 16 Octobre 2026
+ * \version 1.0
+ * 
+ * Ce fichier est inclus une fois par taille de bloc geree par RESOLUTION-2.c,
+ * apres avoir defini n. Toutes les tailles de tableaux, bornes de boucles et
+ * largeurs de masques sont donc des constantes connues a la compilation.
+ * 
+ * Chaque nom du noyau est suffixe par n (backtracking devient backtracking_4, ...)
+ * afin que les noyaux puissent coexister dans le meme programme. Le seul point
+ * d entree utilise depuis RESOLUTION-2.c est resoudre_n.
+ * Avant la premiere inclusion, RESOLUTION-2.c definit tMoteur, tDonneur et donnerTache,
+ * les drapeaux tEtage des etages de propagation, la variante des grilles (tVariante, tClasse),
+ * ainsi que tTranche et tEtatPaquet pour la resolution par paquets.
+ * 
+ * Toutes les macros definies ici, y compris n, sont indefinies en fin de fichier.
+*/
+
+#ifndef n
+#error "n doit etre defini avant d inclure noyau.h"
+#endif
+
+/**
+ * \def NOYAU
+ * \brief Suffixe un nom par la taille de bloc du noyau (nom_n)
+*/
+#define NOYAU(nom) NOYAU_CONCAT(nom, n)
+#define NOYAU_CONCAT(nom, taille) NOYAU_CONCAT_(nom, taille)
+#define NOYAU_CONCAT_(nom, taille) nom##_##taille
+
+#define tMasque                     NOYAU(tMasque)
+#define candidat_grille             NOYAU(candidat_grille)
+#define tGrille                     NOYAU(tGrille)
+#define tContraintes                NOYAU(tContraintes)
+#define tModification               NOYAU(tModification)
+#define tChoix                      NOYAU(tChoix)
+#define tFile                       NOYAU(tFile)
+#define tPile                       NOYAU(tPile)
+#define tTravail                    NOYAU(tTravail)
+#define tVecteur                    NOYAU(tVecteur)
+#define tOctets                     NOYAU(tOctets)
+#define chargerVecteur              NOYAU(chargerVecteur)
+#define rangerVecteur               NOYAU(rangerVecteur)
+#define vecteurVides                NOYAU(vecteurVides)
+#define cachesColonnes              NOYAU(cachesColonnes)
+#define cachesBlocs                 NOYAU(cachesBlocs)
+#define tPaquet                     NOYAU(tPaquet)
+#define reduirePaquet               NOYAU(reduirePaquet)
+#define tFamille                    NOYAU(tFamille)
+#define tSegment                    NOYAU(tSegment)
+#define tTopologie                  NOYAU(tTopologie)
+#define topologie                   NOYAU(topologie)
+#define topologieCalculee           NOYAU(topologieCalculee)
+#define initTopologie               NOYAU(initTopologie)
+#define numeroBloc                  NOYAU(numeroBloc)
+#define initContraintes             NOYAU(initContraintes)
+#define valeursAutorisees           NOYAU(valeursAutorisees)
+#define placerValeur                NOYAU(placerValeur)
+#define enleverValeur               NOYAU(enleverValeur)
+#define backtracking                NOYAU(backtracking)
+#define caseMoinsContrainte         NOYAU(caseMoinsContrainte)
+#define backtrackingMRV             NOYAU(backtrackingMRV)
+#define caseUnite                   NOYAU(caseUnite)
+#define enfiler                     NOYAU(enfiler)
+#define enfilerCase                 NOYAU(enfilerCase)
+#define enfilerTout                 NOYAU(enfilerTout)
+#define viderFile                   NOYAU(viderFile)
+#define inscrireValeur              NOYAU(inscrireValeur)
+#define propagerSingletons          NOYAU(propagerSingletons)
+#define retirerCandidats            NOYAU(retirerCandidats)
+#define eliminerBloques             NOYAU(eliminerBloques)
+#define chercherSousEnsemble        NOYAU(chercherSousEnsemble)
+#define eliminerSousEnsembles       NOYAU(eliminerSousEnsembles)
+#define positionsValeurs            NOYAU(positionsValeurs)
+#define chercherPoisson             NOYAU(chercherPoisson)
+#define eliminerPoissons            NOYAU(eliminerPoissons)
+#define eliminerColoriage           NOYAU(eliminerColoriage)
+#define palierRentable              NOYAU(palierRentable)
+#define appliquerPalier             NOYAU(appliquerPalier)
+#define appliquerEtages             NOYAU(appliquerEtages)
+#define annulerPiste                NOYAU(annulerPiste)
+#define rechercheIterative          NOYAU(rechercheIterative)
+#define premiereCaseVide            NOYAU(premiereCaseVide)
+#define donnerChoix                 NOYAU(donnerChoix)
+#define afficherCandidats           NOYAU(afficherCandidats)
+#define ajouterCandidat             NOYAU(ajouterCandidat)
+#define retirerCandidat             NOYAU(retirerCandidat)
+#define retirerCandidatListe        NOYAU(retirerCandidatListe)
+#define estCandidat                 NOYAU(estCandidat)
+#define nbCandidats                 NOYAU(nbCandidats)
+#define initGrilleCandidat          NOYAU(initGrilleCandidat)
+#define possible                    NOYAU(possible)
+#define initCandidat                NOYAU(initCandidat)
+#define retirerCandidatLigne        NOYAU(retirerCandidatLigne)
+#define retirerCandidatColonne      NOYAU(retirerCandidatColonne)
+#define retirerCandidatRegion       NOYAU(retirerCandidatRegion)
+#define retirerCandidatVariante     NOYAU(retirerCandidatVariante)
+#define checkSingletonNu            NOYAU(checkSingletonNu)
+#define checkSingletonCacheeRegion  NOYAU(checkSingletonCacheeRegion)
+#define checkSingletonCacheeLigne   NOYAU(checkSingletonCacheeLigne)
+#define checkSingletonCacheeColonne NOYAU(checkSingletonCacheeColonne)
+#define checkSingletonCachee        NOYAU(checkSingletonCachee)
+#define donneesCoherentes           NOYAU(donneesCoherentes)
+#define placerSingletons            NOYAU(placerSingletons)
+#define resoudre                    NOYAU(resoudre)
+#define compterSolutions            NOYAU(compterSolutions)
+#define enumererSolutions           NOYAU(enumererSolutions)
+#define denombrerSymetrique         NOYAU(denombrerSymetrique)
+#define denombrerSolutions          NOYAU(denombrerSolutions)
+#define noeudsExplores              NOYAU(noeudsExplores)
+#define lireCompteurs               NOYAU(lireCompteurs)
+
+/**
+ * \def TAILLE
+ * \brief Taille de la grille (n*n)
+*/
+#define TAILLE (n*n)
+
+/**
+ * \typedef tMasque
+ * \brief Ensemble de candidats d une case : le bit (valeur-1) est a 1 si la valeur est candidate
+ * 
+ * Le type est choisi le plus petit possible en fonction de TAILLE,
+ * afin que toute la grille de candidats tienne dans le cache L1.
+*/
+#if TAILLE <= 16
+typedef unsigned short tMasque;
+#elif TAILLE <= 32
+typedef unsigned int tMasque;
+#else
+typedef unsigned long long tMasque;
+#endif
+
+/**
+ * \def TOUTES_VALEURS
+ * \brief Masque contenant toutes les valeurs de 1 a TAILLE
+*/
+#define TOUTES_VALEURS ((tMasque)(~0ULL >> (64 - TAILLE)))
+
+/**
+ * \def BIT
+ * \brief Masque ne contenant que la valeur v
+*/
+#define BIT(v) ((tMasque)(1ULL << ((v) - 1)))
+
+/**
+ * \typedef tVecteur
+ * \brief NB_VOIES masques consecutifs, traites par une meme instruction vectorielle
+ *
+ * Les vecteurs de GCC sont traduits en SSE2, AVX2 ou NEON selon TAILLE_VECTEUR,
+ * et en instructions ordinaires sans jeu d instructions vectoriel.
+*/
+typedef tMasque tVecteur __attribute__((vector_size(TAILLE_VECTEUR)));
+
+/**
+ * \def NB_VOIES
+ * \brief Nombre de masques d un tVecteur
+*/
+#define NB_VOIES ((int) (TAILLE_VECTEUR / sizeof(tMasque)))
+
+/**
+ * \def VOIES
+ * \brief Nombre de masques d une ligne de TAILLE masques a charger a partir de la colonne j
+*/
+#define VOIES(j) (TAILLE - (j) < NB_VOIES ? TAILLE - (j) : NB_VOIES)
+
+// tOctets contient les valeurs des cases correspondant aux voies d un tVecteur
+typedef unsigned char tOctets __attribute__((vector_size(NB_VOIES)));
+
+/**
+ * \struct candidat_grille
+ * \brief Structure representant la grille de jeu et ses candidats
+ * 
+ * La structure candidat_grille contient, sous forme de tableaux separes :
+ * - valeurs : la valeur de chaque case (0 si la case est vide)
+ * - candidats : le masque des candidats possibles de chaque case (0 si la case est remplie)
+ * Le nombre de candidats d une case est le nombre de bits a 1 de son masque.
+ * Compilee avec -DINSTRUMENTATION, elle contient aussi les compteurs de la resolution
+ * en cours, que toutes les fonctions qui la modifient peuvent ainsi incrementer.
+*/
+typedef struct {
+    unsigned char valeurs[TAILLE][TAILLE];
+    tMasque candidats[TAILLE][TAILLE];
+#ifdef INSTRUMENTATION
+    tCompteurs compteurs;
+#endif
+} candidat_grille;
+
+// tGrille est un tableau de TAILLE lignes et TAILLE colonnes contenant la grille de jeu initiale
+typedef int tGrille[TAILLE][TAILLE];
+
+/**
+ * \def NB_FENETRES
+ * \brief Nombre de fenetres d une grille windoku : (n-1) x (n-1) blocs n x n separes d une case
+*/
+#define NB_FENETRES ((n-1)*(n-1))
+
+/**
+ * \def UNITES_MAX
+ * \brief Nombre maximal d unites : lignes, colonnes, regions, deux diagonales et les fenetres
+*/
+#define UNITES_MAX (3*TAILLE + 2 + NB_FENETRES)
+
+/**
+ * \struct tContraintes
+ * \brief Structure representant les valeurs deja utilisees dans la grille
+ * 
+ * La structure tContraintes contient :
+ * - lignes : pour chaque ligne, le masque des valeurs deja placees
+ * - colonnes : pour chaque colonne, le masque des valeurs deja placees
+ * - blocs : pour chaque bloc, le masque des valeurs deja placees
+ * - autres : pour chaque unite de la variante (diagonales, fenetres), le masque des valeurs deja placees
+ * - arret : si non NULL, passe a true quand un autre thread a repondu a la place
+ *   de la recherche, qui s arrete alors
+ * - nbNoeuds : le nombre de valeurs essayees par la recherche
+*/
+typedef struct {
+    tMasque lignes[TAILLE];
+    tMasque colonnes[TAILLE];
+    tMasque blocs[TAILLE];
+    tMasque autres[UNITES_MAX - 3*TAILLE];
+    atomic_bool *arret;
+    long nbNoeuds;
+} tContraintes;
+
+/**
+ * \struct tModification
+ * \brief Entree de la piste d annulation : etat d une case avant sa modification
+ * 
+ * La structure tModification contient :
+ * - numCase : le numero de la case modifiee
+ * - valeur : la valeur de la case avant la modification
+ * - candidats : le masque des candidats de la case avant la modification
+*/
+typedef struct {
+    short numCase;
+    unsigned char valeur;
+    tMasque candidats;
+} tModification;
+
+/**
+ * \struct tChoix
+ * \brief Choix de la recherche iterative
+ * 
+ * La structure tChoix contient :
+ * - numCase : le numero de la case sur laquelle on branche
+ * - restantes : le masque des valeurs qu il reste a essayer dans la case
+ * - marque : la hauteur de la piste avant le choix, a laquelle on revient en cas d echec
+*/
+typedef struct {
+    short numCase;
+    tMasque restantes;
+    int marque;
+} tChoix;
+
+/**
+ * \def CAPACITE_FILE
+ * \brief Nombre d elements distincts de la file de travail : les cases puis les unites
+*/
+#define CAPACITE_FILE (TAILLE*TAILLE + UNITES_MAX)
+
+/**
+ * \def POISSON_MAX
+ * \brief Nombre maximal de bases d un poisson cherche par eliminerPoissons : n, au moins 4
+ * (Jellyfish), sans depasser TAILLE/2
+*/
+#define POISSON_MAX (n < 4 ? (TAILLE/2 < 4 ? TAILLE/2 : 4) : n)
+
+/**
+ * \struct tFile
+ * \brief File de travail de la propagation
+ * 
+ * Un element est soit une case (0 a TAILLE*TAILLE-1), soit une unite
+ * (TAILLE*TAILLE + numero d unite) dont les candidats ont change.
+ * Un element n est jamais present deux fois, la file circulaire
+ * a donc au plus CAPACITE_FILE elements.
+ * 
+ * La structure tFile contient :
+ * - elements : la file circulaire
+ * - debut : l indice du premier element
+ * - nb : le nombre d elements
+ * - dansFile : pour chaque element, true s il est deja dans la file
+*/
+typedef struct {
+    short elements[CAPACITE_FILE];
+    int debut;
+    int nb;
+    bool dansFile[CAPACITE_FILE];
+} tFile;
+
+/**
+ * \struct tPile
+ * \brief Pile de choix et piste d annulation de la recherche iterative
+ * 
+ * Il y a au plus un choix par case vide. Le long d une branche, chaque case
+ * recoit au plus une valeur et perd au plus TAILLE candidats, chacune de ces
+ * modifications ajoutant une entree a la piste : les deux tableaux sont donc
+ * de taille fixe.
+ * La pile contient aussi la file de travail de la propagation, utilisee
+ * seulement si propagation vaut true.
+ * Quand plusieurs threads resolvent la meme grille, donneur permet de leur donner
+ * les valeurs pas encore essayees des premiers choix (NULL sinon), et depart
+ * contient les cases de la grille au debut de la recherche.
+ * La recherche s arrete a la limite-ieme solution trouvee (1 pour resoudre une grille),
+ * nbSolutions compte les solutions trouvees, et la premiere est recopiee dans
+ * premiere si ce n est pas NULL. Si rappel n est pas NULL, il recoit chaque
+ * solution trouvee avec contexte, et peut arreter la recherche.
+ * nbNoeuds compte les valeurs essayees depuis placerSingletons, quel que soit le moteur.
+ * etages contient les drapeaux tEtage appliques par la propagation une fois les
+ * singletons epuises ; essaisPalier et succesPalier comptent les appels du palier
+ * couteux pour la grille en cours, et ceux qui ont retire un candidat.
+*/
+typedef struct {
+    tChoix choix[TAILLE*TAILLE];
+    int nbChoix;
+    tModification piste[TAILLE*TAILLE*(TAILLE+1)];
+    int hauteurPiste;
+    bool propagation;
+    unsigned etages;
+    int essaisPalier;
+    int succesPalier;
+    tFile file;
+    tDonneur *donneur;
+    const int *depart;
+    long limite;
+    long nbSolutions;
+    int *premiere;
+    tRappelSolution rappel;
+    void *contexte;
+    long nbNoeuds;
+} tPile;
+
+/**
+ * \struct tTravail
+ * \brief Etat de resolution propre a un appelant de resoudre
+ * 
+ * Il est alloue au premier appel puis reutilise, ce qui permet a chaque
+ * thread de resoudre des grilles sans partager d etat avec les autres.
+*/
+typedef struct {
+    candidat_grille grille_candidat;
+    tPile pile;
+} tTravail;
+
+/**
+ * \def VOISINS_MAX
+ * \brief Nombre maximal de voisins d une case : les autres cases de ses unites, une par classe au plus
+*/
+#define VOISINS_MAX (NB_CLASSES*(TAILLE - 1))
+
+/**
+ * \def FAMILLES_MAX
+ * \brief Nombre maximal de familles de candidats bloques : une unite et une autre classe d unites
+*/
+#define FAMILLES_MAX (UNITES_MAX*(NB_CLASSES - 1))
+
+/**
+ * \def SEGMENTS_MAX
+ * \brief Nombre maximal de segments des familles, au plus TAILLE par famille
+*/
+#define SEGMENTS_MAX (FAMILLES_MAX*TAILLE)
+
+/**
+ * \struct tSegment
+ * \brief Intersection d une unite avec une unite d une autre classe
+*/
+typedef struct {
+    short croisee;          // unite croisee
+    tMasque rangs;          // rangs des cases de l intersection dans l unite (bit rang+1)
+} tSegment;
+
+/**
+ * \struct tFamille
+ * \brief Decoupage d une unite par les unites d une classe, pour eliminerBloques
+ * 
+ * Seules les familles dont un segment a au moins deux cases sont gardees : une valeur
+ * bloquee dans un segment d une seule case est un singleton cache, deja place.
+*/
+typedef struct {
+    short unite;            // unite decoupee
+    int debut;              // premier segment de la famille dans tTopologie.segments
+    int nb;                 // nombre de segments
+    tMasque hors;           // rangs des cases de l unite qui ne sont dans aucune unite de la classe
+} tFamille;
+
+/**
+ * \struct tTopologie
+ * \brief Unites de contrainte et voisins de chaque case, calcules une fois par initTopologie
+ * 
+ * Les unites sont numerotees comme dans la file de travail : 0 a TAILLE-1 pour les
+ * lignes, TAILLE a 2*TAILLE-1 pour les colonnes, 2*TAILLE a 3*TAILLE-1 pour les blocs
+ * ou les regions, puis celles de la variante : les deux diagonales, puis les fenetres.
+ * Chaque unite a TAILLE cases. Les unites d une case sont rangees par classe : la ligne,
+ * la colonne et la region sont toujours les trois premieres.
+ * Les voisins d une case sont dans l ordre ou les parcourait inscrireValeur (pour chaque
+ * rang, la case de chacune de ses unites), chacun une seule fois ; ceux de la case k
+ * sont voisins[debutVoisins[k]] a voisins[debutVoisins[k+1] - 1].
+*/
+typedef struct {
+    int nbUnites;
+    bool blocsCarres;                                   // les regions sont les blocs n x n
+    short cases[UNITES_MAX][TAILLE];                    // cases de chaque unite, par rang
+    unsigned char classes[UNITES_MAX];                  // tClasse de chaque unite
+    short parClasse[TAILLE*TAILLE][NB_CLASSES];         // unite de chaque classe de la case, -1 sans
+    unsigned char nbUnitesCase[TAILLE*TAILLE];
+    short unites[TAILLE*TAILLE][NB_CLASSES];            // unites de chaque case
+    unsigned char rangs[TAILLE*TAILLE][NB_CLASSES];     // rang de chaque case dans ses unites
+    int debutVoisins[TAILLE*TAILLE + 1];
+    short voisins[TAILLE*TAILLE*VOISINS_MAX];
+    int nbFamilles;
+    tFamille familles[FAMILLES_MAX];
+    tSegment segments[SEGMENTS_MAX];
+} tTopologie;
+
+/**
+ * \var topologie
+ * \brief Unites et voisins des cases du noyau, en lecture seule une fois initTopologie appelee
+*/
+static tTopologie topologie;
+
+/**
+ * \var topologieCalculee
+ * \brief Garantit que initTopologie est appelee une seule fois, par le premier appelant du noyau
+ * qui alloue son etat de resolution
+*/
+static pthread_once_t topologieCalculee = PTHREAD_ONCE_INIT;
+
+// Backtracking functions
+void initTopologie(void);
+int numeroBloc(int numLigne, int numColonne);
+void initContraintes(tContraintes *contraintes, candidat_grille *grille_candidat);
+tMasque valeursAutorisees(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne);
+void placerValeur(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne, int valeur);
+void enleverValeur(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne, int valeur);
+bool backtracking(candidat_grille *grille_candidat, tContraintes *contraintes, int numCase);
+int caseMoinsContrainte(candidat_grille *grille_candidat, tContraintes *contraintes, tMasque *autorisees);
+bool backtrackingMRV(candidat_grille *grille_candidat, tContraintes *contraintes);
+void enfilerTout(tFile *file);
+void viderFile(tFile *file);
+bool propagerSingletons(candidat_grille *grille_candidat, tPile *pile);
+bool eliminerBloques(candidat_grille *grille_candidat, tPile *pile);
+bool eliminerSousEnsembles(candidat_grille *grille_candidat, tPile *pile, int taille, bool caches);
+bool eliminerPoissons(candidat_grille *grille_candidat, tPile *pile, tMasque positions[][UNITES_MAX]);
+bool eliminerColoriage(candidat_grille *grille_candidat, tPile *pile, tMasque positions[][UNITES_MAX]);
+bool appliquerPalier(candidat_grille *grille_candidat, tPile *pile);
+bool appliquerEtages(candidat_grille *grille_candidat, tPile *pile);
+bool rechercheIterative(candidat_grille *grille_candidat, tPile *pile, bool propagation);
+int premiereCaseVide(candidat_grille *grille_candidat);
+void donnerChoix(candidat_grille *grille_candidat, tPile *pile);
+
+// Candidats functions
+void initGrilleCandidat(candidat_grille *grille_candidat, tGrille grille);
+void initCandidat(candidat_grille *grille_candidat);
+bool possible(candidat_grille *grille, int num_ligne, int num_colonne, int valeur);
+void afficherCandidats(candidat_grille *grille_candidat, int num_ligne, int num_colonne);
+void ajouterCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur);
+void retirerCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur);
+bool estCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur);
+int nbCandidats(candidat_grille *grille_candidat, int num_ligne, int num_colonne);
+
+// Noyaux vectoriels
+void cachesColonnes(candidat_grille *grille_candidat, tMasque caches[TAILLE]);
+void cachesBlocs(candidat_grille *grille_candidat, tMasque caches[TAILLE]);
+
+// Singleton nu
+bool checkSingletonNu(candidat_grille *grille);
+
+// Singleton cachee
+void retirerCandidatLigne(candidat_grille *grille_candidat, int num_lig, int valeur);
+void retirerCandidatColonne(candidat_grille *grille, int num_col, int valeur);
+void retirerCandidatRegion(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur);
+void retirerCandidatVariante(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur);
+void checkSingletonCacheeRegion(candidat_grille *grille, int num_unite, bool *action_effectuee);
+void checkSingletonCacheeLigne(candidat_grille *grille_candidat, int num_ligne, bool *action_effectuee);
+void checkSingletonCacheeColonne(candidat_grille *grille_candidat, int num_col, bool *action_effectuee);
+bool checkSingletonCachee(candidat_grille *grille_candidat);
+
+// Point d entree
+bool donneesCoherentes(candidat_grille *grille_candidat);
+bool placerSingletons(candidat_grille *grille_candidat, tPile *pile, int *cases, bool balayage);
+bool resoudre(int *cases, tMoteur moteur, bool balayage, unsigned etages, void **travail, tDonneur *donneur);
+long compterSolutions(int *cases, tMoteur moteur, bool balayage, unsigned etages, long limite, void **travail);
+long enumererSolutions(int *cases, tMoteur moteur, bool balayage, unsigned etages, long limite, tRappelSolution rappel, void *contexte, void **travail);
+long denombrerSymetrique(candidat_grille *grille_candidat, tPile *pile, tMasque absentes, long limite);
+long denombrerSolutions(int *cases, bool balayage, unsigned etages, long limite, void **travail);
+long noeudsExplores(void *travail);
+void reduirePaquet(int **grilles, int nbGrilles, tEtatPaquet *etats, void **travail);
+#ifdef INSTRUMENTATION
+const tCompteurs *lireCompteurs(void *travail);
+#endif
+
+/**
+ * \fn void initTopologie(void)
+ * \brief Calcule les unites et les voisins de chaque case du noyau, selon la variante
+ * 
+ * C est le seul endroit ou les unites sont deduites des coordonnees et de la variante :
+ * la propagation et les verifications parcourent ensuite les tableaux de topologie.
+ * Les points d entree l appellent par pthread_once en allouant leur etat de resolution :
+ * seuls les noyaux utilises calculent leurs tables (1,4 Mo de voisins pour n = 8 sans
+ * variante), et la variante doit donc etre fixee avant la premiere resolution.
+*/
+void initTopologie(void) {
+    const unsigned char *regions = (variante.tailleRegions == n) ? variante.regions : NULL;
+    int vu[TAILLE*TAILLE];      // derniere case dont le voisin a ete note
+    int rempli[UNITES_MAX];     // nombre de cases deja rangees dans chaque unite
+    int parClasse[NB_CLASSES];  // unite de chaque classe de la case en cours, -1 sans
+    int i, j, t, c, d, k, u, s, voisin, nb, diagonale, fenetres;
+    tFamille *famille;
+    bool utile;
+
+    // numeros des unites de la variante, a la suite des regions
+    topologie.nbUnites = 3*TAILLE;
+    diagonale = topologie.nbUnites;
+    if (variante.diagonales) {
+        topologie.nbUnites += 2;
+    }
+    fenetres = topologie.nbUnites;
+    if (variante.fenetres) {
+        topologie.nbUnites += NB_FENETRES;
+    }
+    topologie.blocsCarres = (regions == NULL);
+
+    // unites de chaque case, puis cases de chaque unite dans l ordre des lignes
+    for (u = 0; u < topologie.nbUnites; u++) {
+        rempli[u] = 0;
+    }
+    for (k = 0; k < TAILLE*TAILLE; k++) {
+        i = k / TAILLE;
+        j = k % TAILLE;
+        parClasse[CLASSE_LIGNE] = i;
+        parClasse[CLASSE_COLONNE] = TAILLE + j;
+        parClasse[CLASSE_REGION] = 2*TAILLE + (regions != NULL ? regions[k] : (i/n)*n + j/n);
+        parClasse[CLASSE_DIAGONALE] = (variante.diagonales && i == j) ? diagonale : -1;
+        parClasse[CLASSE_ANTIDIAGONALE] = (variante.diagonales && i + j == TAILLE - 1) ? diagonale + 1 : -1;
+        parClasse[CLASSE_FENETRE] = (variante.fenetres && i%(n+1) != 0 && j%(n+1) != 0)
+                                  ? fenetres + (i/(n+1))*(n-1) + j/(n+1) : -1;
+        nb = 0;
+        for (c = 0; c < NB_CLASSES; c++) {
+            topologie.parClasse[k][c] = (short) parClasse[c];
+            u = parClasse[c];
+            if (u >= 0) {
+                topologie.classes[u] = (unsigned char) c;
+                topologie.unites[k][nb] = (short) u;
+                topologie.rangs[k][nb] = (unsigned char) rempli[u];
+                topologie.cases[u][rempli[u]++] = (short) k;
+                nb++;
+            }
+        }
+        topologie.nbUnitesCase[k] = (unsigned char) nb;
+        vu[k] = -1;
+    }
+
+    // voisins : les cases des unites de la case, rang par rang
+    nb = 0;
+    for (k = 0; k < TAILLE*TAILLE; k++) {
+        topologie.debutVoisins[k] = nb;
+        vu[k] = k;
+        for (t = 0; t < TAILLE; t++) {
+            for (d = 0; d < topologie.nbUnitesCase[k]; d++) {
+                voisin = topologie.cases[topologie.unites[k][d]][t];
+                if (vu[voisin] != k) {
+                    vu[voisin] = k;
+                    topologie.voisins[nb++] = (short) voisin;
+                }
+            }
+        }
+    }
+    topologie.debutVoisins[TAILLE*TAILLE] = nb;
+
+    // familles : chaque unite coupee par les unites de chaque autre classe
+    topologie.nbFamilles = 0;
+    nb = 0;
+    for (u = 0; u < topologie.nbUnites; u++) {
+        for (c = 0; c < NB_CLASSES; c++) {
+            if (c == topologie.classes[u]) {
+                continue;
+            }
+            famille = &topologie.familles[topologie.nbFamilles];
+            famille->unite = (short) u;
+            famille->debut = nb;
+            famille->nb = 0;
+            famille->hors = 0;
+            utile = false;
+            for (t = 0; t < TAILLE; t++) {
+                voisin = topologie.parClasse[topologie.cases[u][t]][c];
+                if (voisin < 0) {
+                    famille->hors |= BIT(t + 1);
+                    continue;
+                }
+                s = 0;
+                while (s < famille->nb && topologie.segments[nb + s].croisee != voisin) {
+                    s++;
+                }
+                if (s == famille->nb) {
+                    topologie.segments[nb + s].croisee = (short) voisin;
+                    topologie.segments[nb + s].rangs = 0;
+                    famille->nb++;
+                }
+                utile = utile || topologie.segments[nb + s].rangs != 0;
+                topologie.segments[nb + s].rangs |= BIT(t + 1);
+            }
+            if (utile) {
+                topologie.nbFamilles++;
+                nb += famille->nb;
+            }
+        }
+    }
+}
+
+/**
+ * \fn int numeroBloc(int numLigne, int numColonne)
+ * \brief Determine le numero du bloc contenant une case
+ * \param numLigne Numero de la ligne de la case selectionnee
+ * \param numColonne Numero de la colonne de la case selectionnee
+ * 
+ * \return Numero du bloc, les blocs etant numerotes de gauche a droite et de haut en bas
+*/
+int numeroBloc(int numLigne, int numColonne) {
+    return topologie.unites[numLigne*TAILLE + numColonne][2] - 2*TAILLE;
+}
+
+/**
+ * \fn void initContraintes(tContraintes *contraintes, candidat_grille *grille_candidat)
+ * \brief Initialise les masques des valeurs utilisees a partir de la grille
+ * \param contraintes Masques a initialiser
+ * \param grille_candidat Grille de jeu
+ * 
+ * Cette fonction parcourt la grille une seule fois et ajoute chaque valeur
+ * deja placee au masque de sa ligne, de sa colonne, de son bloc et de ses autres unites.
+*/
+void initContraintes(tContraintes *contraintes, candidat_grille *grille_candidat) {
+    int i, j, d;
+
+    for (i = 0; i < TAILLE; i++) {
+        contraintes->lignes[i] = 0;
+        contraintes->colonnes[i] = 0;
+        contraintes->blocs[i] = 0;
+    }
+    for (i = 0; i < topologie.nbUnites - 3*TAILLE; i++) {
+        contraintes->autres[i] = 0;
+    }
+    contraintes->arret = NULL;
+    contraintes->nbNoeuds = 0;
+    for (i = 0; i < TAILLE; i++) {
+        for (j = 0; j < TAILLE; j++) {
+            if (grille_candidat->valeurs[i][j] != 0) {
+                contraintes->lignes[i] |= BIT(grille_candidat->valeurs[i][j]);
+                contraintes->colonnes[j] |= BIT(grille_candidat->valeurs[i][j]);
+                contraintes->blocs[numeroBloc(i, j)] |= BIT(grille_candidat->valeurs[i][j]);
+                for (d = 3; d < topologie.nbUnitesCase[i*TAILLE + j]; d++) {
+                    contraintes->autres[topologie.unites[i*TAILLE + j][d] - 3*TAILLE] |= BIT(grille_candidat->valeurs[i][j]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \fn tMasque valeursAutorisees(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne)
+ * \brief Determine les valeurs autorisees dans une case
+ * \param grille_candidat Grille de candidats
+ * \param contraintes Masques des valeurs utilisees
+ * \param numLigne Numero de la ligne de la case selectionnee
+ * \param numColonne Numero de la colonne de la case selectionnee
+ * 
+ * \return Masque des candidats de la case encore absents de sa ligne, de sa colonne, de son bloc
+ * et de ses autres unites
+ * 
+ * Les candidats elimines avant la recherche (singletons) ne sont donc jamais essayes.
+*/
+tMasque valeursAutorisees(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne) {
+    const short *unites = topologie.unites[numLigne*TAILLE + numColonne];
+    tMasque utilisees = contraintes->lignes[numLigne]
+                      | contraintes->colonnes[numColonne]
+                      | contraintes->blocs[numeroBloc(numLigne, numColonne)];
+
+    for (int d = 3; d < topologie.nbUnitesCase[numLigne*TAILLE + numColonne]; d++) {
+        utilisees |= contraintes->autres[unites[d] - 3*TAILLE];
+    }
+    return grille_candidat->candidats[numLigne][numColonne] & (tMasque)~utilisees;
+}
+
+/**
+ * \fn void placerValeur(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne, int valeur)
+ * \brief Inscrit une valeur dans une case et met a jour les masques
+ * \param grille_candidat Grille de jeu
+ * \param contraintes Masques des valeurs utilisees
+ * \param numLigne Numero de la ligne de la case selectionnee
+ * \param numColonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur a inscrire
+*/
+void placerValeur(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne, int valeur) {
+    grille_candidat->valeurs[numLigne][numColonne] = valeur;
+    contraintes->lignes[numLigne] |= BIT(valeur);
+    contraintes->colonnes[numColonne] |= BIT(valeur);
+    contraintes->blocs[numeroBloc(numLigne, numColonne)] |= BIT(valeur);
+    for (int d = 3; d < topologie.nbUnitesCase[numLigne*TAILLE + numColonne]; d++) {
+        contraintes->autres[topologie.unites[numLigne*TAILLE + numColonne][d] - 3*TAILLE] |= BIT(valeur);
+    }
+}
+
+/**
+ * \fn void enleverValeur(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne, int valeur)
+ * \brief Vide une case et retire sa valeur des masques
+ * \param grille_candidat Grille de jeu
+ * \param contraintes Masques des valeurs utilisees
+ * \param numLigne Numero de la ligne de la case selectionnee
+ * \param numColonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur inscrite dans la case
+*/
+void enleverValeur(candidat_grille *grille_candidat, tContraintes *contraintes, int numLigne, int numColonne, int valeur) {
+    grille_candidat->valeurs[numLigne][numColonne] = 0;
+    contraintes->lignes[numLigne] &= (tMasque)~BIT(valeur);
+    contraintes->colonnes[numColonne] &= (tMasque)~BIT(valeur);
+    contraintes->blocs[numeroBloc(numLigne, numColonne)] &= (tMasque)~BIT(valeur);
+    for (int d = 3; d < topologie.nbUnitesCase[numLigne*TAILLE + numColonne]; d++) {
+        contraintes->autres[topologie.unites[numLigne*TAILLE + numColonne][d] - 3*TAILLE] &= (tMasque)~BIT(valeur);
+    }
+}
+
+/**
+ * \fn bool backtracking(candidat_grille *grille_candidat, tContraintes *contraintes, int numCase)
+ * \brief Resout la grille de jeu par backtracking
+ * \param grille_candidat Grille de jeu
+ * \param contraintes Masques des valeurs utilisees, tenus a jour pendant la recherche
+ * \param numCase Numero de la case a traiter
+ * 
+ * \return true si la grille est resolue, false sinon
+ * 
+ * Cette fonction resout la grille de jeu par backtracking.
+ * Elle verifie si la case est vide, si oui, elle teste les valeurs autorisees
+ * (bits a 1 du masque renvoye par valeursAutorisees) et inscrit chacune d elles
+ * dans la case avant de passer a la case suivante.
+ * Si aucune valeur n est autorisee, elle revient en arriere et teste une autre valeur.
+ * Si la case n est pas vide, elle passe a la case suivante.
+*/
+bool backtracking(candidat_grille *grille_candidat, tContraintes *contraintes, int numCase){
+    int lig, col, val;
+    tMasque autorisees;
+    bool res = false;
+
+    if (contraintes->arret != NULL && atomic_load_explicit(contraintes->arret, memory_order_relaxed)) {
+        // un autre thread a repondu
+        res = false;
+    } else if(numCase == TAILLE*TAILLE){
+        // On a traité tout les cases, la grille est résolue
+        TRACER(TRACE_SOLUTION, 0, 0, 0);
+        res = true;
+    } else {
+        // On récupère les "coordonnées" de la case
+        lig = numCase / TAILLE;
+        col = numCase % TAILLE;
+        if (grille_candidat->valeurs[lig][col] != 0) {
+            // La case n'est pas vide, on passe à la suivante
+            // (appel récursif)
+            res = backtracking(grille_candidat, contraintes, numCase+1);
+        } else {
+            autorisees = valeursAutorisees(grille_candidat, contraintes, lig, col);
+            while (autorisees != 0 && !res) {
+                // On extrait la plus petite valeur autorisée du masque
+                val = __builtin_ctzll(autorisees) + 1;
+                autorisees &= autorisees - 1;
+
+                // On l'inscrit dans la case
+                placerValeur(grille_candidat, contraintes, lig, col, val);
+                contraintes->nbNoeuds++;
+                COMPTER(entrerChoix(&grille_candidat->compteurs));
+                TRACER(TRACE_CHOIX, 0, lig*TAILLE + col, val);
+                // Et on passe à la case suivante : appel récursif
+                // pour voir si ce choix est bon par la suite
+                if (backtracking(grille_candidat, contraintes, numCase+1) == true) {
+                    res = true;
+                } else {
+                    enleverValeur(grille_candidat, contraintes, lig, col, val);
+                    COMPTER(grille_candidat->compteurs.retours++);
+                    TRACER(TRACE_RETOUR, 0, 0, 0);
+                }
+                COMPTER(grille_candidat->compteurs.profondeur--);
+            }
+        } 
+    }
+    return res;
+}
+
+/**
+ * \fn int caseMoinsContrainte(candidat_grille *grille_candidat, tContraintes *contraintes, tMasque *autorisees)
+ * \brief Determine la case vide ayant le moins de valeurs autorisees
+ * \param grille_candidat Grille de jeu
+ * \param contraintes Masques des valeurs utilisees
+ * \param autorisees Masque des valeurs autorisees dans la case choisie (sortie)
+ * 
+ * \return Numero de la case choisie, -1 si la grille ne contient plus de case vide
+ * 
+ * Cette fonction parcourt les cases vides et retient celle qui a le moins
+ * de valeurs autorisees. En cas d egalite, elle retient la case dont la ligne,
+ * la colonne, le bloc et les autres unites contiennent le plus de cases vides,
+ * c est-a-dire celle qui contraint le plus de cases voisines.
+ * Le parcours s arrete des qu une case a zero ou une seule valeur autorisee :
+ * avec zero valeur la branche est un echec, avec une seule le choix est force.
+*/
+int caseMoinsContrainte(candidat_grille *grille_candidat, tContraintes *contraintes, tMasque *autorisees) {
+    int i, j, d, nb, degre;
+    int meilleureCase = -1;
+    int meilleurNb = TAILLE + 1;
+    int meilleurDegre = -1;
+    tMasque masque;
+
+    *autorisees = 0;
+    for (i = 0; i < TAILLE && meilleurNb > 1; i++) {
+        for (j = 0; j < TAILLE && meilleurNb > 1; j++) {
+            if (grille_candidat->valeurs[i][j] == 0) {
+                masque = valeursAutorisees(grille_candidat, contraintes, i, j);
+                nb = __builtin_popcountll(masque);
+                // nombre de cases vides dans les unites de la case
+                degre = 3*TAILLE - __builtin_popcountll(contraintes->lignes[i])
+                                 - __builtin_popcountll(contraintes->colonnes[j])
+                                 - __builtin_popcountll(contraintes->blocs[numeroBloc(i, j)]);
+                for (d = 3; d < topologie.nbUnitesCase[i*TAILLE + j]; d++) {
+                    degre += TAILLE - __builtin_popcountll(contraintes->autres[topologie.unites[i*TAILLE + j][d] - 3*TAILLE]);
+                }
+                if (nb < meilleurNb || (nb == meilleurNb && degre > meilleurDegre)) {
+                    meilleureCase = i*TAILLE + j;
+                    meilleurNb = nb;
+                    meilleurDegre = degre;
+                    *autorisees = masque;
+                }
+            }
+        }
+    }
+    return meilleureCase;
+}
+
+/**
+ * \fn bool backtrackingMRV(candidat_grille *grille_candidat, tContraintes *contraintes)
+ * \brief Resout la grille de jeu par backtracking en choisissant la case la plus contrainte
+ * \param grille_candidat Grille de jeu
+ * \param contraintes Masques des valeurs utilisees, tenus a jour pendant la recherche
+ * 
+ * \return true si la grille est resolue, false sinon
+ * 
+ * Cette fonction resout la grille comme backtracking, mais au lieu de
+ * traiter les cases dans l ordre, elle branche a chaque etape sur la case
+ * choisie par caseMoinsContrainte (heuristique MRV, "minimum remaining values").
+ * Si cette case n a aucune valeur autorisee, la branche echoue immediatement.
+*/
+bool backtrackingMRV(candidat_grille *grille_candidat, tContraintes *contraintes) {
+    int numCase, lig, col, val;
+    tMasque autorisees;
+    bool res = false;
+
+    if (contraintes->arret != NULL && atomic_load_explicit(contraintes->arret, memory_order_relaxed)) {
+        // un autre thread a repondu
+        return false;
+    }
+    numCase = caseMoinsContrainte(grille_candidat, contraintes, &autorisees);
+    if (numCase == -1) {
+        // Il n'y a plus de case vide, la grille est résolue
+        TRACER(TRACE_SOLUTION, 0, 0, 0);
+        res = true;
+    } else {
+        lig = numCase / TAILLE;
+        col = numCase % TAILLE;
+        while (autorisees != 0 && !res) {
+            val = __builtin_ctzll(autorisees) + 1;
+            autorisees &= autorisees - 1;
+
+            placerValeur(grille_candidat, contraintes, lig, col, val);
+            contraintes->nbNoeuds++;
+            COMPTER(entrerChoix(&grille_candidat->compteurs));
+            TRACER(TRACE_CHOIX, 0, numCase, val);
+            if (backtrackingMRV(grille_candidat, contraintes) == true) {
+                res = true;
+            } else {
+                enleverValeur(grille_candidat, contraintes, lig, col, val);
+                COMPTER(grille_candidat->compteurs.retours++);
+                TRACER(TRACE_RETOUR, 0, 0, 0);
+            }
+            COMPTER(grille_candidat->compteurs.profondeur--);
+        }
+    }
+    return res;
+}
+
+/**
+ * \fn int caseUnite(int numUnite, int rang)
+ * \brief Determine le numero d une case d une unite (ligne, colonne, bloc ou unite de la variante)
+ * \param numUnite Numero de l unite : 0 a TAILLE-1 pour les lignes, TAILLE a 2*TAILLE-1
+ * pour les colonnes, 2*TAILLE a 3*TAILLE-1 pour les blocs, puis les unites de la variante
+ * \param rang Rang de la case dans l unite, entre 0 et TAILLE-1
+ * 
+ * \return Numero de la case (ligne*TAILLE + colonne), lu dans topologie
+*/
+static inline int caseUnite(int numUnite, int rang) {
+    return topologie.cases[numUnite][rang];
+}
+
+/**
+ * \fn void enfiler(tFile *file, int element)
+ * \brief Ajoute une case ou une unite a la file de travail si elle n y est pas deja
+ * \param file File de travail
+ * \param element Numero de case, ou TAILLE*TAILLE + numero d unite
+*/
+static inline void enfiler(tFile *file, int element) {
+    if (!file->dansFile[element]) {
+        file->dansFile[element] = true;
+        file->elements[(file->debut + file->nb) % CAPACITE_FILE] = element;
+        file->nb++;
+    }
+}
+
+/**
+ * \fn void enfilerCase(tFile *file, int numCase)
+ * \brief Ajoute une case et ses unites a la file de travail
+ * \param file File de travail
+ * \param numCase Numero de la case dont les candidats ont change
+*/
+static inline void enfilerCase(tFile *file, int numCase) {
+    const short *unites = topologie.unites[numCase];
+
+    enfiler(file, numCase);
+    enfiler(file, TAILLE*TAILLE + unites[0]);
+    enfiler(file, TAILLE*TAILLE + unites[1]);
+    enfiler(file, TAILLE*TAILLE + unites[2]);
+    for (int d = 3; d < topologie.nbUnitesCase[numCase]; d++) {
+        enfiler(file, TAILLE*TAILLE + unites[d]);
+    }
+}
+
+/**
+ * \fn void enfilerTout(tFile *file)
+ * \brief Remplit la file de travail avec toutes les cases et toutes les unites
+ * \param file File de travail
+ * 
+ * Utilisee avant la premiere propagation, quand rien n a encore ete examine.
+*/
+void enfilerTout(tFile *file) {
+    file->debut = 0;
+    file->nb = 0;
+    for (int i = 0; i < CAPACITE_FILE; i++) {
+        file->dansFile[i] = false;
+    }
+    for (int i = 0; i < TAILLE*TAILLE + topologie.nbUnites; i++) {
+        enfiler(file, i);
+    }
+}
+
+/**
+ * \fn void viderFile(tFile *file)
+ * \brief Vide la file de travail apres une contradiction
+ * \param file File de travail
+*/
+void viderFile(tFile *file) {
+    while (file->nb > 0) {
+        file->dansFile[file->elements[file->debut]] = false;
+        file->debut = (file->debut + 1) % CAPACITE_FILE;
+        file->nb--;
+    }
+}
+
+/**
+ * \fn bool inscrireValeur(candidat_grille *grille_candidat, tPile *pile, int numCase, int val)
+ * \brief Inscrit une valeur dans une case et la retire des candidats de ses voisines
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit l etat precedent de chaque case modifiee
+ * \param numCase Numero de la case (ligne*TAILLE + colonne)
+ * \param val Valeur a inscrire
+ * 
+ * \return false si une case voisine vide n a plus aucun candidat, true sinon
+ * 
+ * Seules les cases dont le masque change sont ajoutees a la piste. Si la propagation
+ * est active, ces cases et leurs unites sont aussi ajoutees a la file de travail.
+ * Avec l instrumentation, la valeur et les candidats retires sont comptes pour la
+ * technique en cours (compteurs.technique), choisie par l appelant.
+*/
+static inline bool inscrireValeur(candidat_grille *grille_candidat, tPile *pile, int numCase, int val) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    const short *voisins = &topologie.voisins[topologie.debutVoisins[numCase]];
+    int nbVoisins = topologie.debutVoisins[numCase + 1] - topologie.debutVoisins[numCase];
+    tModification *modif;
+    int t, k;
+    tMasque bit = BIT(val);
+    bool ok = true;
+
+    // inscription de la valeur
+    modif = &pile->piste[pile->hauteurPiste++];
+    modif->numCase = numCase;
+    modif->valeur = 0;
+    modif->candidats = candidats[numCase];
+    valeurs[numCase] = val;
+    candidats[numCase] = 0;
+    COMPTER(grille_candidat->compteurs.placements[grille_candidat->compteurs.technique]++);
+    if (pile->propagation) {
+        enfilerCase(&pile->file, numCase);
+    }
+
+    // retrait de la valeur chez les voisins de la case
+    for (t = 0; t < nbVoisins && ok; t++) {
+        k = voisins[t];
+        if (candidats[k] & bit) {
+            modif = &pile->piste[pile->hauteurPiste++];
+            modif->numCase = k;
+            modif->valeur = valeurs[k];
+            modif->candidats = candidats[k];
+            candidats[k] &= (tMasque)~bit;
+            COMPTER(grille_candidat->compteurs.eliminations[grille_candidat->compteurs.technique]++);
+            if (candidats[k] == 0) {
+                // Case vide sans candidat : contradiction
+                ok = false;
+            } else if (pile->propagation) {
+                enfilerCase(&pile->file, k);
+            }
+        }
+    }
+    return ok;
+}
+
+/**
+ * \fn bool retirerCandidats(candidat_grille *grille_candidat, tPile *pile, int numCase, tMasque masque)
+ * \brief Retire plusieurs candidats d une case en notant son etat precedent dans la piste
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit l etat precedent de la case, et la file la case et ses unites
+ * \param numCase Numero de la case (ligne*TAILLE + colonne)
+ * \param masque Valeurs a retirer, candidates ou non dans la case
+ * 
+ * \return false si la case n a plus aucun candidat, true sinon
+ * 
+ * Une seule entree est ajoutee a la piste, quel que soit le nombre de candidats
+ * retires : chaque entree retirant au moins un candidat, la piste reste bornee.
+*/
+static inline bool retirerCandidats(candidat_grille *grille_candidat, tPile *pile, int numCase, tMasque masque) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tMasque retires = candidats[numCase] & masque;
+    tModification *modif;
+
+    if (retires == 0) {
+        return true;
+    }
+    modif = &pile->piste[pile->hauteurPiste++];
+    modif->numCase = numCase;
+    modif->valeur = valeurs[numCase];
+    modif->candidats = candidats[numCase];
+    candidats[numCase] &= (tMasque)~retires;
+    COMPTER(grille_candidat->compteurs.eliminations[grille_candidat->compteurs.technique] += __builtin_popcountll(retires));
+    enfilerCase(&pile->file, numCase);
+    return candidats[numCase] != 0;
+}
+
+/**
+ * \fn bool eliminerBloques(candidat_grille *grille_candidat, tPile *pile)
+ * \brief Retire les candidats bloques dans l intersection de deux unites
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit toutes les modifications
+ * 
+ * \return false si une case n a plus de candidat, true sinon
+ * 
+ * Chaque famille de la topologie coupe une unite en segments, ses intersections avec
+ * les unites d une autre classe : les blocs pour une ligne ou une colonne, les lignes
+ * puis les colonnes pour un bloc, et de meme avec les regions et les unites de la
+ * variante. Les masques des segments sont accumules en distinguant les valeurs vues
+ * dans un segment de celles vues dans plusieurs. Une valeur candidate dans un seul
+ * segment, et dans aucune case de l unite hors des segments, y sera placee : elle est
+ * retiree du reste de l unite croisee (candidats pointants pour un bloc, reduction
+ * bloc-ligne pour une ligne ou une colonne).
+*/
+bool eliminerBloques(candidat_grille *grille_candidat, tPile *pile) {
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tMasque segments[TAILLE];
+    tMasque vuesUneFois, vuesPlusieurs, hors, bloquees, rangs;
+    const tFamille *famille;
+    const tSegment *segment;
+    const short *cases;
+    int f, s, t, k, classe;
+    bool ok = true;
+
+    COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_BLOQUES);
+    for (f = 0; f < topologie.nbFamilles && ok; f++) {
+        famille = &topologie.familles[f];
+        segment = &topologie.segments[famille->debut];
+        cases = topologie.cases[famille->unite];
+        vuesUneFois = 0;
+        vuesPlusieurs = 0;
+        for (s = 0; s < famille->nb; s++) {
+            segments[s] = 0;
+            for (rangs = segment[s].rangs; rangs != 0; rangs &= rangs - 1) {
+                segments[s] |= candidats[cases[__builtin_ctzll(rangs)]];
+            }
+            vuesPlusieurs |= vuesUneFois & segments[s];
+            vuesUneFois |= segments[s];
+        }
+        hors = 0;
+        for (rangs = famille->hors; rangs != 0; rangs &= rangs - 1) {
+            hors |= candidats[cases[__builtin_ctzll(rangs)]];
+        }
+        bloquees = vuesUneFois & (tMasque)~(vuesPlusieurs | hors);
+
+        classe = topologie.classes[famille->unite];
+        for (s = 0; s < famille->nb && ok && bloquees != 0; s++) {
+            if ((segments[s] & bloquees) == 0) {
+                continue;
+            }
+            for (t = 0; t < TAILLE && ok; t++) {
+                k = caseUnite(segment[s].croisee, t);
+                if (topologie.parClasse[k][classe] != famille->unite) {
+                    ok = retirerCandidats(grille_candidat, pile, k, segments[s] & bloquees);
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+/**
+ * \fn bool chercherSousEnsemble(candidat_grille *grille_candidat, tPile *pile, int numUnite, bool caches, const tMasque *masques, int taille, int debut, tMasque membres, tMasque reunion)
+ * \brief Applique les sous-ensembles de taille elements d une unite dont la reunion a taille bits
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit toutes les modifications
+ * \param numUnite Numero de l unite, comme pour caseUnite
+ * \param caches false pour un sous-ensemble nu (elements : les cases, masques : leurs
+ * candidats), true pour un sous-ensemble cache (elements : les valeurs, masques : leurs rangs)
+ * \param masques Masque de chaque element, 0 pour un element ecarte
+ * \param taille Nombre d elements du sous-ensemble
+ * \param debut Premier element pas encore examine
+ * \param membres Elements deja choisis (bit i+1 pour l element i)
+ * \param reunion Reunion des masques deja choisis
+ * 
+ * \return false si une contradiction est detectee, true sinon
+ * 
+ * Les elements sont choisis par rang croissant, et une branche est abandonnee des que
+ * la reunion depasse taille bits. taille cases dont les candidats tiennent en taille
+ * valeurs les prennent toutes : ces valeurs sont retirees des autres cases de l unite.
+ * taille valeurs qui ne sont candidates que dans taille cases les occupent toutes :
+ * les autres candidats de ces cases sont retires. Moins de taille bits dans la reunion
+ * est une contradiction.
+*/
+static bool chercherSousEnsemble(candidat_grille *grille_candidat, tPile *pile, int numUnite, bool caches,
+                                 const tMasque *masques, int taille, int debut, tMasque membres, tMasque reunion) {
+    int t;
+    bool ok = true;
+
+    if (__builtin_popcountll(membres) == taille) {
+        if (__builtin_popcountll(reunion) < taille) {
+            return false;
+        }
+        for (t = 0; t < TAILLE && ok; t++) {
+            if (!caches && !(membres & BIT(t + 1))) {
+                ok = retirerCandidats(grille_candidat, pile, caseUnite(numUnite, t), reunion);
+            } else if (caches && (reunion & BIT(t + 1))) {
+                ok = retirerCandidats(grille_candidat, pile, caseUnite(numUnite, t), (tMasque)~membres);
+            }
+        }
+        return ok;
+    }
+    for (int i = debut; i < TAILLE && ok; i++) {
+        if (masques[i] != 0 && __builtin_popcountll(reunion | masques[i]) <= taille) {
+            ok = chercherSousEnsemble(grille_candidat, pile, numUnite, caches, masques, taille,
+                                      i + 1, membres | BIT(i + 1), reunion | masques[i]);
+        }
+    }
+    return ok;
+}
+
+/**
+ * \fn bool eliminerSousEnsembles(candidat_grille *grille_candidat, tPile *pile, int taille, bool caches)
+ * \brief Retire les candidats exclus par les paires, triplets ou quadruplets nus ou caches
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit toutes les modifications
+ * \param taille Taille des sous-ensembles cherches, de 2 a 4
+ * \param caches false pour les sous-ensembles nus, true pour les sous-ensembles caches
+ * 
+ * \return false si une contradiction est detectee, true sinon
+ * 
+ * Dans chaque unite, seuls les elements de 2 a taille bits peuvent faire partie d un
+ * sous-ensemble : les cases vides ayant de 2 a taille candidats, ou les valeurs
+ * candidates dans 2 a taille cases. Les rangs des cases de chaque valeur sont obtenus
+ * en parcourant une fois les candidats de l unite. Les masques sont ceux du debut de
+ * l unite : retirer des candidats ne fait que reduire les reunions, les sous-ensembles
+ * trouves restent donc valables.
+*/
+bool eliminerSousEnsembles(candidat_grille *grille_candidat, tPile *pile, int taille, bool caches) {
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tMasque masques[TAILLE];
+    tMasque reste;
+    int u, t, nb;
+    bool ok = true;
+
+    COMPTER(grille_candidat->compteurs.technique = caches ? TECHNIQUE_SOUS_ENSEMBLE_CACHE : TECHNIQUE_SOUS_ENSEMBLE_NU);
+    for (u = 0; u < topologie.nbUnites && ok; u++) {
+        if (caches) {
+            for (t = 0; t < TAILLE; t++) {
+                masques[t] = 0;
+            }
+            for (t = 0; t < TAILLE; t++) {
+                reste = candidats[caseUnite(u, t)];
+                while (reste != 0) {
+                    masques[__builtin_ctzll(reste)] |= BIT(t + 1);
+                    reste &= reste - 1;
+                }
+            }
+        } else {
+            for (t = 0; t < TAILLE; t++) {
+                masques[t] = candidats[caseUnite(u, t)];
+            }
+        }
+        for (t = 0; t < TAILLE; t++) {
+            nb = __builtin_popcountll(masques[t]);
+            if (nb < 2 || nb > taille) {
+                masques[t] = 0;
+            }
+        }
+        ok = chercherSousEnsemble(grille_candidat, pile, u, caches, masques, taille, 0, 0, 0);
+    }
+    return ok;
+}
+
+/**
+ * \fn void positionsValeurs(candidat_grille *grille_candidat, tMasque positions[][UNITES_MAX])
+ * \brief Calcule, pour chaque valeur et chaque unite, les cases de l unite ou la valeur est candidate
+ * \param grille_candidat Grille de candidats
+ * \param positions positions[v-1][u] recoit le bit rang+1 pour chaque case caseUnite(u, rang)
+ * ou v est candidate
+ * 
+ * C est la transposee des masques de candidats, calculee une fois par appel du palier
+ * couteux : les poissons et le coloriage raisonnent valeur par valeur.
+*/
+static inline void positionsValeurs(candidat_grille *grille_candidat, tMasque positions[][UNITES_MAX]) {
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tMasque masque;
+    int v;
+
+    memset(positions, 0, TAILLE * sizeof(positions[0]));
+    for (int k = 0; k < TAILLE*TAILLE; k++) {
+        for (masque = candidats[k]; masque != 0; masque &= masque - 1) {
+            v = __builtin_ctzll(masque);
+            for (int d = 0; d < topologie.nbUnitesCase[k]; d++) {
+                positions[v][topologie.unites[k][d]] |= BIT(topologie.rangs[k][d] + 1);
+            }
+        }
+    }
+}
+
+/**
+ * \fn bool chercherPoisson(candidat_grille *grille_candidat, tPile *pile, tMasque bit, bool colonnes, const tMasque *masques, const tMasque *croisees, int taille, int debut, tMasque bases, tMasque couvertures)
+ * \brief Cherche les poissons d une valeur : taille lignes dont les candidats tiennent dans taille colonnes
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit toutes les modifications
+ * \param bit Masque de la valeur
+ * \param colonnes false si les bases sont des lignes et les couvertures des colonnes, true pour l inverse
+ * \param masques Pour chaque base, les couvertures ou la valeur est candidate, 0 pour une base ecartee
+ * \param croisees Pour chaque couverture, les bases ou la valeur est candidate
+ * \param taille Nombre de bases du poisson : 2 pour un X-Wing, 3 pour un Swordfish, 4 pour un Jellyfish
+ * \param debut Premiere base pas encore examinee
+ * \param bases Bases deja choisies (bit i+1 pour la base i)
+ * \param couvertures Reunion des masques des bases deja choisies
+ * 
+ * \return false si une contradiction est detectee, true sinon
+ * 
+ * La valeur doit etre placee une fois dans chaque base, donc dans chacune des taille
+ * couvertures : elle est retiree des autres cases des couvertures. La recherche est
+ * celle de chercherSousEnsemble, sur les positions d une valeur dans toute la grille.
+*/
+static bool chercherPoisson(candidat_grille *grille_candidat, tPile *pile, tMasque bit, bool colonnes,
+                            const tMasque *masques, const tMasque *croisees, int taille, int debut,
+                            tMasque bases, tMasque couvertures) {
+    tMasque autres;
+    int c, b;
+    bool ok = true;
+
+    if (__builtin_popcountll(bases) == taille) {
+        if (__builtin_popcountll(couvertures) < taille) {
+            return false;
+        }
+        for (; couvertures != 0 && ok; couvertures &= couvertures - 1) {
+            c = __builtin_ctzll(couvertures);
+            for (autres = croisees[c] & ~bases; autres != 0 && ok; autres &= autres - 1) {
+                b = __builtin_ctzll(autres);
+                ok = retirerCandidats(grille_candidat, pile, colonnes ? c*TAILLE + b : b*TAILLE + c, bit);
+            }
+        }
+        return ok;
+    }
+    for (int i = debut; i < TAILLE && ok; i++) {
+        if (masques[i] != 0 && __builtin_popcountll(couvertures | masques[i]) <= taille) {
+            ok = chercherPoisson(grille_candidat, pile, bit, colonnes, masques, croisees, taille,
+                                 i + 1, bases | BIT(i + 1), couvertures | masques[i]);
+        }
+    }
+    return ok;
+}
+
+/**
+ * \fn bool eliminerPoissons(candidat_grille *grille_candidat, tPile *pile, tMasque positions[][UNITES_MAX])
+ * \brief Retire les candidats exclus par les poissons de 2 a POISSON_MAX lignes ou colonnes
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit toutes les modifications
+ * \param positions Positions de chaque valeur dans chaque unite (positionsValeurs)
+ * 
+ * \return false si une contradiction est detectee, true sinon
+ * 
+ * Les poissons sont cherches par taille croissante, pour chaque valeur, avec les lignes
+ * puis les colonnes pour bases : la recherche s arrete a la premiere taille qui retire
+ * un candidat. Un poisson de k lignes parmi les m ou la valeur reste a placer est le
+ * complement d un poisson de m-k colonnes : chercher dans les deux sens jusqu a m/2
+ * bases suffit, et POISSON_MAX borne m/2 pour les grandes grilles. Les positions ne
+ * sont pas remises a jour apres un retrait : elles contiennent alors trop de
+ * candidats, et un poisson qu elles donnent reste un poisson.
+*/
+bool eliminerPoissons(candidat_grille *grille_candidat, tPile *pile, tMasque positions[][UNITES_MAX]) {
+    tMasque masques[TAILLE];
+    int hauteur = pile->hauteurPiste;
+    int nb, nbBases, nbRestantes;
+    bool ok = true;
+
+    COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_POISSON);
+    for (int taille = 2; taille <= POISSON_MAX && ok && pile->hauteurPiste == hauteur; taille++) {
+        for (int v = 0; v < TAILLE && ok; v++) {
+            for (int sens = 0; sens < 2 && ok; sens++) {
+                nbBases = 0;
+                nbRestantes = 0;
+                for (int b = 0; b < TAILLE; b++) {
+                    masques[b] = positions[v][sens*TAILLE + b];
+                    nb = __builtin_popcountll(masques[b]);
+                    nbRestantes += (nb != 0);
+                    if (nb < 2 || nb > taille) {
+                        masques[b] = 0;
+                    } else {
+                        nbBases++;
+                    }
+                }
+                if (nbBases >= taille && 2*taille <= nbRestantes) {
+                    ok = chercherPoisson(grille_candidat, pile, BIT(v + 1), sens == 1, masques,
+                                         &positions[v][(1 - sens)*TAILLE], taille, 0, 0, 0);
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+/**
+ * \fn bool eliminerColoriage(candidat_grille *grille_candidat, tPile *pile, tMasque positions[][UNITES_MAX])
+ * \brief Retire les candidats exclus par le coloriage simple des paires conjuguees
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit toutes les modifications
+ * \param positions Positions de chaque valeur dans chaque unite (positionsValeurs)
+ * 
+ * \return false si une contradiction est detectee, true sinon
+ * 
+ * Pour chaque valeur, une unite ou elle n est candidate que dans deux cases forme une
+ * paire conjuguee : exactement une des deux cases la recevra. Les chaines de paires
+ * conjuguees sont coloriees en alternant deux couleurs, dont une seule est vraie.
+ * - Si deux cases de meme couleur sont dans une meme unite, cette couleur est fausse :
+ *   la valeur est retiree de toutes ses cases.
+ * - Sinon, une case hors de la chaine qui voit les deux couleurs (bout d une chaine X
+ *   de liens forts) ne peut pas recevoir la valeur.
+ * Une chaine qui se referme sur un nombre impair de paires est une contradiction.
+*/
+bool eliminerColoriage(candidat_grille *grille_candidat, tPile *pile, tMasque positions[][UNITES_MAX]) {
+    int paires[UNITES_MAX][2];
+    int vueA[UNITES_MAX], vueB[UNITES_MAX];     // c+1 si l unite contient une case de la premiere (seconde) couleur de la chaine c
+    int couleur[TAILLE*TAILLE];             // 0 : hors chaine, 2c+1 et 2c+2 : les deux couleurs de la chaine c
+    int ordre[TAILLE*TAILLE];               // cases coloriees, chaine par chaine
+    const short *unites;
+    int u, i, j, k, a, c, debutChaine, nbOrdre, fausse;
+    int *vue;
+    tMasque masque;
+    bool voitA, voitB;
+    bool ok = true;
+
+    COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_COLORIAGE);
+    for (int v = 0; v < TAILLE && ok; v++) {
+        for (u = 0; u < topologie.nbUnites; u++) {
+            masque = positions[v][u];
+            paires[u][0] = -1;
+            paires[u][1] = -1;
+            if (__builtin_popcountll(masque) == 2) {
+                paires[u][0] = caseUnite(u, __builtin_ctzll(masque));
+                paires[u][1] = caseUnite(u, __builtin_ctzll(masque & (masque - 1)));
+            }
+            vueA[u] = 0;
+            vueB[u] = 0;
+        }
+        memset(couleur, 0, sizeof(couleur));
+
+        nbOrdre = 0;
+        c = 0;
+        for (u = 0; u < topologie.nbUnites && ok; u++) {
+            if (paires[u][0] == -1 || couleur[paires[u][0]] != 0) {
+                continue;
+            }
+            // coloriage en largeur de la chaine qui passe par la paire
+            debutChaine = nbOrdre;
+            couleur[paires[u][0]] = 2*c + 1;
+            ordre[nbOrdre++] = paires[u][0];
+            for (i = debutChaine; i < nbOrdre && ok; i++) {
+                k = ordre[i];
+                unites = topologie.unites[k];
+                for (j = 0; j < topologie.nbUnitesCase[k] && ok; j++) {
+                    if (paires[unites[j]][0] == k || paires[unites[j]][1] == k) {
+                        a = paires[unites[j]][0] == k ? paires[unites[j]][1] : paires[unites[j]][0];
+                        if (couleur[a] == 0) {
+                            couleur[a] = (couleur[k] % 2 == 1) ? couleur[k] + 1 : couleur[k] - 1;
+                            ordre[nbOrdre++] = a;
+                        } else if (couleur[a] == couleur[k]) {
+                            // Cycle impair de paires conjuguees : contradiction
+                            ok = false;
+                        }
+                    }
+                }
+            }
+
+            // unites vues par chaque couleur, et couleur vue deux fois dans une unite
+            fausse = 0;
+            for (i = debutChaine; i < nbOrdre && ok; i++) {
+                k = ordre[i];
+                unites = topologie.unites[k];
+                vue = (couleur[k] % 2 == 1) ? vueA : vueB;
+                for (j = 0; j < topologie.nbUnitesCase[k]; j++) {
+                    if (vue[unites[j]] == c + 1) {
+                        fausse = couleur[k];
+                    }
+                    vue[unites[j]] = c + 1;
+                }
+            }
+            if (fausse != 0) {
+                for (i = debutChaine; i < nbOrdre && ok; i++) {
+                    if (couleur[ordre[i]] == fausse) {
+                        ok = retirerCandidats(grille_candidat, pile, ordre[i], BIT(v + 1));
+                    }
+                }
+            } else {
+                // cases hors de la chaine qui voient les deux couleurs
+                for (int lig = 0; lig < TAILLE && ok; lig++) {
+                    for (masque = positions[v][lig]; masque != 0 && ok; masque &= masque - 1) {
+                        k = lig*TAILLE + __builtin_ctzll(masque);
+                        if (couleur[k] == 2*c + 1 || couleur[k] == 2*c + 2) {
+                            continue;
+                        }
+                        unites = topologie.unites[k];
+                        voitA = false;
+                        voitB = false;
+                        for (j = 0; j < topologie.nbUnitesCase[k]; j++) {
+                            voitA = voitA || vueA[unites[j]] == c + 1;
+                            voitB = voitB || vueB[unites[j]] == c + 1;
+                        }
+                        if (voitA && voitB) {
+                            ok = retirerCandidats(grille_candidat, pile, k, BIT(v + 1));
+                        }
+                    }
+                }
+            }
+            c++;
+        }
+    }
+    return ok;
+}
+
+/**
+ * \fn bool palierRentable(tPile *pile)
+ * \brief Indique si le palier couteux rapporte assez pour etre encore essaye sur la grille
+ * \param pile Pile qui compte les essais et les succes du palier depuis placerSingletons
+ * 
+ * \return false apres ESSAIS_PALIER essais si moins d un sur ESSAIS_PALIER a reussi
+*/
+static inline bool palierRentable(tPile *pile) {
+    return pile->essaisPalier < ESSAIS_PALIER || pile->succesPalier * ESSAIS_PALIER >= pile->essaisPalier;
+}
+
+/**
+ * \fn bool appliquerPalier(candidat_grille *grille_candidat, tPile *pile)
+ * \brief Applique le palier couteux (poissons, coloriage) quand les etages ne retirent plus rien
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont etages choisit les techniques, et qui compte les essais du palier
+ * 
+ * \return false si une contradiction est detectee, true sinon
+ * 
+ * Chaque appel est un essai, reussi s il retire un candidat ou trouve une contradiction.
+ * appliquerEtages n appelle plus le palier quand il ne rapporte pas (palierRentable).
+*/
+bool appliquerPalier(candidat_grille *grille_candidat, tPile *pile) {
+    tMasque positions[TAILLE][UNITES_MAX];
+    int hauteur = pile->hauteurPiste;
+    bool ok = true;
+    COMPTER(double debut = tempsEcoule());
+
+    pile->essaisPalier++;
+    positionsValeurs(grille_candidat, positions);
+    if (pile->etages & ETAGE_POISSONS) {
+        ok = eliminerPoissons(grille_candidat, pile, positions);
+    }
+    if (ok && pile->hauteurPiste == hauteur && (pile->etages & ETAGE_COLORIAGE)) {
+        ok = eliminerColoriage(grille_candidat, pile, positions);
+    }
+    if (!ok || pile->hauteurPiste != hauteur) {
+        pile->succesPalier++;
+    }
+    COMPTER(grille_candidat->compteurs.essaisPalier = pile->essaisPalier;
+            grille_candidat->compteurs.succesPalier = pile->succesPalier;
+            grille_candidat->compteurs.tempsPalier += tempsEcoule() - debut);
+    return ok;
+}
+
+/**
+ * \fn bool appliquerEtages(candidat_grille *grille_candidat, tPile *pile)
+ * \brief Applique les etages de propagation choisis, une fois les singletons epuises
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont etages choisit les etages, et dont la file recoit les cases modifiees
+ * 
+ * \return false si une contradiction est detectee, true sinon
+ * 
+ * Les etages sont essayes du moins couteux au plus couteux : candidats bloques, puis
+ * paires, triplets et quadruplets, nus puis caches, et enfin le palier couteux
+ * (appliquerPalier) tant qu il rapporte. Des qu un etage retire un candidat,
+ * les suivants attendent : les singletons qu il a pu creer sont propages d abord.
+*/
+bool appliquerEtages(candidat_grille *grille_candidat, tPile *pile) {
+    int hauteur = pile->hauteurPiste;
+    bool ok = true;
+    COMPTER(double debut = tempsEcoule());
+
+    if (pile->etages & ETAGE_BLOQUES) {
+        ok = eliminerBloques(grille_candidat, pile);
+    }
+    for (int taille = 2; taille <= 4 && ok && pile->hauteurPiste == hauteur; taille++) {
+        if (pile->etages & (ETAGE_PAIRES << (taille - 2))) {
+            ok = eliminerSousEnsembles(grille_candidat, pile, taille, false);
+        }
+        if (ok && pile->hauteurPiste == hauteur && (pile->etages & (ETAGE_PAIRES_CACHEES << (taille - 2)))) {
+            ok = eliminerSousEnsembles(grille_candidat, pile, taille, true);
+        }
+    }
+    if (ok && pile->hauteurPiste == hauteur && (pile->etages & (ETAGE_POISSONS | ETAGE_COLORIAGE))
+        && palierRentable(pile)) {
+        ok = appliquerPalier(grille_candidat, pile);
+    }
+    COMPTER(grille_candidat->compteurs.tempsEtages += tempsEcoule() - debut);
+    return ok;
+}
+
+/**
+ * \fn bool propagerSingletons(candidat_grille *grille_candidat, tPile *pile)
+ * \brief Inscrit les singletons nus et caches jusqu a ce qu il n y en ait plus
+ * \param grille_candidat Grille de candidats
+ * \param pile Pile dont la piste recoit toutes les modifications
+ * 
+ * \return false si une contradiction est detectee, true sinon
+ * 
+ * Seules les cases et les unites presentes dans la file de travail sont examinees :
+ * chaque modification n enfile que les cases voisines qu elle touche et leurs unites,
+ * et la file est videe jusqu au point fixe. Le travail est donc proportionnel aux
+ * voisins des cases modifiees et non a la taille de la grille.
+ * 
+ * Un singleton nu est une case vide n ayant qu un candidat. Un singleton cache
+ * est une valeur qui n est candidate que dans une case d une ligne, d une colonne
+ * ou d un bloc. Pour chaque unite, on accumule les masques des cases en distinguant
+ * les valeurs vues une fois de celles vues plusieurs fois.
+ * Il y a contradiction si une case vide n a plus de candidat, ou si une valeur
+ * n est ni placee ni candidate dans une unite.
+ * Quand la file est vide, les etages de pile->etages (appliquerEtages) cherchent
+ * d autres candidats a retirer, et la propagation reprend s ils en trouvent.
+ * Toutes les modifications passent par la piste et sont donc annulees
+ * avec le choix qui les a provoquees.
+*/
+bool propagerSingletons(candidat_grille *grille_candidat, tPile *pile) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tFile *file = &pile->file;
+    tMasque vuesUneFois, vuesPlusieurs, placees, caches, bit;
+    int element, k, u, t, val;
+    bool ok = true;
+
+    while (ok && file->nb > 0) {
+        element = file->elements[file->debut];
+        file->debut = (file->debut + 1) % CAPACITE_FILE;
+        file->nb--;
+        file->dansFile[element] = false;
+
+        if (element < TAILLE*TAILLE) {
+            // singleton nu
+            k = element;
+            if (valeurs[k] == 0) {
+                if (candidats[k] == 0) {
+                    ok = false;
+                } else if ((candidats[k] & (candidats[k] - 1)) == 0) {
+                    COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_PROPAGATION_NU);
+                    TRACER(TRACE_SINGLETON, TECHNIQUE_PROPAGATION_NU, k, __builtin_ctzll(candidats[k]) + 1);
+                    ok = inscrireValeur(grille_candidat, pile, k, __builtin_ctzll(candidats[k]) + 1);
+                }
+            }
+        } else {
+            // singletons caches de l unite
+            u = element - TAILLE*TAILLE;
+            vuesUneFois = 0;
+            vuesPlusieurs = 0;
+            placees = 0;
+            for (t = 0; t < TAILLE; t++) {
+                k = caseUnite(u, t);
+                vuesPlusieurs |= vuesUneFois & candidats[k];
+                vuesUneFois |= candidats[k];
+                if (valeurs[k] != 0) {
+                    placees |= BIT(valeurs[k]);
+                }
+            }
+
+            if ((tMasque)(vuesUneFois | placees) != TOUTES_VALEURS) {
+                // Une valeur n'a plus de place dans l'unité
+                ok = false;
+            }
+
+            caches = vuesUneFois & (tMasque)~vuesPlusieurs;
+            while (caches != 0 && ok) {
+                val = __builtin_ctzll(caches) + 1;
+                bit = BIT(val);
+                caches &= caches - 1;
+
+                t = 0;
+                while (t < TAILLE && !(candidats[caseUnite(u, t)] & bit)) {
+                    t++;
+                }
+                if (t == TAILLE) {
+                    // La seule case possible a reçu une autre valeur entre temps
+                    ok = false;
+                } else {
+                    COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_PROPAGATION_CACHEE);
+                    TRACER(TRACE_SINGLETON, TECHNIQUE_PROPAGATION_CACHEE, caseUnite(u, t), val);
+                    ok = inscrireValeur(grille_candidat, pile, caseUnite(u, t), val);
+                }
+            }
+        }
+
+        if (ok && file->nb == 0 && pile->etages != 0) {
+            // plus de singleton : les etages choisis enfilent les cases dont ils retirent des candidats
+            ok = appliquerEtages(grille_candidat, pile);
+        }
+    }
+
+    if (!ok) {
+        viderFile(file);
+    }
+    return ok;
+}
+
+/**
+ * \fn void annulerPiste(candidat_grille *grille_candidat, tPile *pile, int marque)
+ * \brief Annule les modifications de la piste jusqu a une hauteur donnee
+ * \param grille_candidat Grille de candidats, remise dans son etat a cette hauteur
+ * \param pile Pile dont la piste est depilee
+ * \param marque Hauteur de la piste a retrouver
+*/
+static inline void annulerPiste(candidat_grille *grille_candidat, tPile *pile, int marque) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tModification *modif;
+
+    while (pile->hauteurPiste > marque) {
+        pile->hauteurPiste--;
+        modif = &pile->piste[pile->hauteurPiste];
+        valeurs[modif->numCase] = modif->valeur;
+        candidats[modif->numCase] = modif->candidats;
+    }
+}
+
+/**
+ * \fn bool rechercheIterative(candidat_grille *grille_candidat, tPile *pile, bool propagation)
+ * \brief Resout la grille par une recherche iterative avec pile de choix et piste d annulation
+ * \param grille_candidat Grille de candidats, dont les candidats doivent etre a jour
+ * \param pile Pile de choix et piste d annulation utilisees pendant la recherche
+ * \param propagation true pour propager les singletons apres chaque choix
+ * 
+ * \return true si la recherche s est arretee sur une solution (la pile->limite-ieme, ou
+ * celle pour laquelle pile->rappel a rendu false), false sinon (pile->nbSolutions donne
+ * alors le nombre de solutions, inferieur a la limite)
+ * 
+ * Cette fonction effectue la meme recherche que backtrackingMRV sans recursion.
+ * Chaque choix est empile dans pile->choix avec les valeurs qu il reste a essayer,
+ * sa hauteur est donc bornee par le nombre de cases vides.
+ * Inscrire une valeur retire cette valeur des candidats des cases de la meme ligne,
+ * colonne et region (verification en avant) : l etat precedent de chaque case
+ * modifiee est ajoute a la piste. Revenir sur un choix consiste a depiler la piste
+ * jusqu a la marque du choix, sans rien recalculer.
+ * Une case vide qui n a plus aucun candidat fait echouer le choix immediatement.
+ * 
+ * Avec la propagation, propagerSingletons est appelee apres chaque choix
+ * (maintien de la coherence, "MAC") : les singletons deduits sont annules avec
+ * le choix, et une contradiction elague la branche sans la parcourir.
+ * 
+ * Si pile->donneur n est pas NULL, la recherche s arrete des qu un autre thread
+ * a trouve la solution, et donne des branches aux threads inactifs (donnerChoix).
+ * 
+ * Tant que la limite n est pas atteinte, une solution est comptee puis la recherche
+ * continue avec la valeur suivante du dernier choix, comme apres un echec.
+ * 
+ * La piste reprend a pile->hauteurPiste : les modifications deja faites par l appelant
+ * restent en dessous et ne sont pas annulees.
+*/
+bool rechercheIterative(candidat_grille *grille_candidat, tPile *pile, bool propagation) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tChoix *choix;
+    int k, numCase, nb, meilleurNb, val;
+    bool arret;
+    bool descendre = true;
+    bool fini = false;
+    bool res = false;
+
+    pile->nbChoix = 0;
+    pile->propagation = propagation;
+    pile->nbSolutions = 0;
+    COMPTER(double debutPropagation);
+
+    if (propagation) {
+        COMPTER(debutPropagation = tempsEcoule());
+        enfilerTout(&pile->file);
+        if (!propagerSingletons(grille_candidat, pile)) {
+            // La grille est contradictoire avant tout choix
+            fini = true;
+        }
+        COMPTER(grille_candidat->compteurs.tempsPropagation += tempsEcoule() - debutPropagation);
+    }
+
+    while (!fini) {
+        if (pile->donneur != NULL) {
+            if (atomic_load_explicit(pile->donneur->arret, memory_order_relaxed)) {
+                break;
+            }
+            if (descendre && pile->donneur->profondeurMax > 0 && atomic_load_explicit(&pile->donneur->pool->inactifs, memory_order_relaxed) > 0) {
+                donnerChoix(grille_candidat, pile);
+            }
+        }
+        if (descendre) {
+            // choix de la case vide ayant le moins de candidats
+            numCase = -1;
+            meilleurNb = TAILLE + 1;
+            for (k = 0; k < TAILLE*TAILLE && meilleurNb > 1; k++) {
+                if (valeurs[k] == 0) {
+                    nb = __builtin_popcountll(candidats[k]);
+                    if (nb < meilleurNb) {
+                        numCase = k;
+                        meilleurNb = nb;
+                    }
+                }
+            }
+            if (numCase == -1) {
+                // Il n'y a plus de case vide, la grille est résolue
+                TRACER(TRACE_SOLUTION, 0, 0, 0);
+                pile->nbSolutions++;
+                if (pile->nbSolutions == 1 && pile->premiere != NULL) {
+                    for (k = 0; k < TAILLE*TAILLE; k++) {
+                        pile->premiere[k] = valeurs[k];
+                    }
+                }
+                arret = (pile->rappel != NULL && !pile->rappel(valeurs, pile->contexte));
+                if (arret || pile->nbSolutions >= pile->limite) {
+                    res = true;
+                    fini = true;
+                } else {
+                    // on cherche la solution suivante
+                    descendre = false;
+                    fini = (pile->nbChoix == 0);
+                }
+            } else {
+                choix = &pile->choix[pile->nbChoix];
+                choix->numCase = numCase;
+                choix->restantes = candidats[numCase];
+                choix->marque = pile->hauteurPiste;
+                pile->nbChoix++;
+                COMPTER(if (pile->nbChoix > grille_candidat->compteurs.profondeurMax) {
+                            grille_candidat->compteurs.profondeurMax = pile->nbChoix;
+                        })
+            }
+        }
+
+        if (!fini) {
+            choix = &pile->choix[pile->nbChoix - 1];
+            if (!descendre) {
+                // la derniere valeur essayee n a pas abouti (ou la solution trouvee est comptee)
+                COMPTER(grille_candidat->compteurs.retours++);
+                TRACER(TRACE_RETOUR, 0, 0, 0);
+            }
+
+            // annulation des modifications faites depuis le choix
+            annulerPiste(grille_candidat, pile, choix->marque);
+
+            if (choix->restantes == 0) {
+                // Toutes les valeurs ont échoué : on revient au choix précédent
+                pile->nbChoix--;
+                descendre = false;
+                fini = (pile->nbChoix == 0);
+            } else {
+                val = __builtin_ctzll(choix->restantes) + 1;
+                choix->restantes &= choix->restantes - 1;
+                pile->nbNoeuds++;
+
+                COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_CHOIX);
+                TRACER(TRACE_CHOIX, 0, choix->numCase, val);
+                descendre = inscrireValeur(grille_candidat, pile, choix->numCase, val);
+                if (descendre && propagation) {
+                    COMPTER(debutPropagation = tempsEcoule());
+                    descendre = propagerSingletons(grille_candidat, pile);
+                    COMPTER(grille_candidat->compteurs.tempsPropagation += tempsEcoule() - debutPropagation);
+                }
+            }
+        }
+    }
+    return res;
+}
+
+/**
+ * \fn void donnerChoix(candidat_grille *grille_candidat, tPile *pile)
+ * \brief Donne aux threads inactifs les valeurs restantes du premier choix qui en a
+ * \param grille_candidat Grille de candidats, tous les choix de la pile etant inscrits
+ * \param pile Pile de choix de la recherche, avec son donneur
+ * 
+ * Le premier choix de la pile qui a encore des valeurs a essayer, s il est a une
+ * profondeur inferieure a donneur->profondeurMax, porte le plus gros sous-arbre
+ * pas encore parcouru. Chacune de ses valeurs restantes devient une tache :
+ * la grille de depart, les valeurs des choix precedents et cette valeur.
+ * Les valeurs donnees sont retirees du choix, le thread ne les essaiera pas.
+*/
+void donnerChoix(candidat_grille *grille_candidat, tPile *pile) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    int cases[TAILLE*TAILLE];
+    int profondeur = 0;
+    int val;
+    tChoix *choix;
+
+    while (profondeur < pile->nbChoix && profondeur < pile->donneur->profondeurMax
+           && pile->choix[profondeur].restantes == 0) {
+        profondeur++;
+    }
+    if (profondeur == pile->nbChoix || profondeur == pile->donneur->profondeurMax) {
+        return;
+    }
+
+    for (int k = 0; k < TAILLE*TAILLE; k++) {
+        cases[k] = pile->depart[k];
+    }
+    for (int i = 0; i < profondeur; i++) {
+        cases[pile->choix[i].numCase] = valeurs[pile->choix[i].numCase];
+    }
+    choix = &pile->choix[profondeur];
+    while (choix->restantes != 0) {
+        val = __builtin_ctzll(choix->restantes) + 1;
+        cases[choix->numCase] = val;
+        if (!donnerTache(pile->donneur, cases)) {
+            // plus de memoire : le thread garde les valeurs restantes
+            return;
+        }
+        choix->restantes &= choix->restantes - 1;
+    }
+}
+
+/**
+ * \fn int premiereCaseVide(candidat_grille *grille_candidat)
+ * \brief Determine la premiere case vide de la grille
+ * \param grille_candidat Grille de jeu
+ * 
+ * \return Numero de la premiere case vide de la grille
+ * 
+ * Cette fonction determine la premiere case vide de la grille
+ * en parcourant la grille de gauche a droite et de haut en bas.
+ * Si aucune case vide n est trouvee, la fonction retourne -1.
+*/
+int premiereCaseVide(candidat_grille *grille_candidat) {
+    int i, j;
+    bool trouve = false;
+    i = 0;
+    while (i < TAILLE && !trouve) {
+        j = 0;
+        while (j < TAILLE && !trouve) {
+            if (grille_candidat->valeurs[i][j] == 0) {
+                trouve = true;
+            }
+            j++;
+        }
+        i++;
+    }
+    return (i-1)*TAILLE + (j-1);
+}
+
+/*****************************************************
+ *                 NOYAUX VECTORIELS                 *
+ *****************************************************/
+
+/**
+ * \fn tVecteur chargerVecteur(const tMasque *masques, int nb)
+ * \brief Charge des masques consecutifs dans un vecteur
+ * \param masques Premier masque
+ * \param nb Nombre de masques a charger, au plus NB_VOIES : les autres voies valent 0
+ *
+ * \return Vecteur des masques
+*/
+static inline tVecteur chargerVecteur(const tMasque *masques, int nb) {
+    tVecteur v = {0};
+    memcpy(&v, masques, nb * sizeof(tMasque));
+    return v;
+}
+
+/**
+ * \fn void rangerVecteur(tMasque *masques, tVecteur v, int nb)
+ * \brief Range les premieres voies d un vecteur dans des masques consecutifs
+ * \param masques Premier masque
+ * \param v Vecteur a ranger
+ * \param nb Nombre de voies a ranger, au plus NB_VOIES
+*/
+static inline void rangerVecteur(tMasque *masques, tVecteur v, int nb) {
+    memcpy(masques, &v, nb * sizeof(tMasque));
+}
+
+/**
+ * \fn tVecteur vecteurVides(candidat_grille *grille_candidat, int num_ligne, int num_colonne)
+ * \brief Indique quelles cases d une ligne sont vides, a partir d une colonne
+ * \param grille_candidat Grille de jeu
+ * \param num_ligne Numero de la ligne
+ * \param num_colonne Premiere colonne
+ *
+ * \return Vecteur dont chaque voie vaut ~0 si la case est vide, 0 si elle est remplie
+ * (ou au-dela de la ligne)
+*/
+static inline tVecteur vecteurVides(candidat_grille *grille_candidat, int num_ligne, int num_colonne) {
+    tOctets valeurs;
+
+    memset(&valeurs, 0xFF, sizeof(valeurs));
+    memcpy(&valeurs, &grille_candidat->valeurs[num_ligne][num_colonne], VOIES(num_colonne));
+    return (tVecteur) (__builtin_convertvector(valeurs, tVecteur) == 0);
+}
+
+/**
+ * \fn void cachesColonnes(candidat_grille *grille_candidat, tMasque caches[TAILLE])
+ * \brief Cherche les singletons caches de toutes les colonnes a la fois
+ * \param grille_candidat Grille de candidats
+ * \param caches Pour chaque colonne, les valeurs candidates dans une seule de ses cases
+ *
+ * Les lignes sont parcourues une a une, NB_VOIES colonnes par vecteur : chaque voie
+ * accumule les candidats vus une fois et ceux vus plusieurs fois dans sa colonne.
+*/
+void cachesColonnes(candidat_grille *grille_candidat, tMasque caches[TAILLE]) {
+    tVecteur vuesUneFois, vuesPlusieurs, candidats;
+
+    for (int j = 0; j < TAILLE; j += NB_VOIES) {
+        vuesUneFois = (tVecteur) {0};
+        vuesPlusieurs = (tVecteur) {0};
+        for (int i = 0; i < TAILLE; i++) {
+            candidats = chargerVecteur(&grille_candidat->candidats[i][j], VOIES(j));
+            vuesPlusieurs |= vuesUneFois & candidats;
+            vuesUneFois |= candidats;
+        }
+        rangerVecteur(&caches[j], vuesUneFois & ~vuesPlusieurs, VOIES(j));
+    }
+}
+
+/**
+ * \fn void cachesBlocs(candidat_grille *grille_candidat, tMasque caches[TAILLE])
+ * \brief Cherche les singletons caches de tous les blocs a la fois
+ * \param grille_candidat Grille de candidats
+ * \param caches Pour chaque bloc (numeroBloc), les valeurs candidates dans une seule de ses cases
+ *
+ * Les n lignes de chaque bande sont accumulees comme dans cachesColonnes, puis les
+ * n colonnes de chaque bloc de la bande sont reunies de la meme facon.
+*/
+void cachesBlocs(candidat_grille *grille_candidat, tMasque caches[TAILLE]) {
+    tVecteur vuesUneFois, vuesPlusieurs, candidats;
+    tMasque uneFois[TAILLE], plusieurs[TAILLE];
+    tMasque blocUneFois, blocPlusieurs;
+
+    for (int bande = 0; bande < n; bande++) {
+        for (int j = 0; j < TAILLE; j += NB_VOIES) {
+            vuesUneFois = (tVecteur) {0};
+            vuesPlusieurs = (tVecteur) {0};
+            for (int i = bande*n; i < bande*n + n; i++) {
+                candidats = chargerVecteur(&grille_candidat->candidats[i][j], VOIES(j));
+                vuesPlusieurs |= vuesUneFois & candidats;
+                vuesUneFois |= candidats;
+            }
+            rangerVecteur(&uneFois[j], vuesUneFois, VOIES(j));
+            rangerVecteur(&plusieurs[j], vuesPlusieurs, VOIES(j));
+        }
+        for (int b = 0; b < n; b++) {
+            blocUneFois = 0;
+            blocPlusieurs = 0;
+            for (int j = b*n; j < b*n + n; j++) {
+                blocPlusieurs |= plusieurs[j] | (blocUneFois & uneFois[j]);
+                blocUneFois |= uneFois[j];
+            }
+            caches[bande*n + b] = blocUneFois & (tMasque)~blocPlusieurs;
+        }
+    }
+}
+
+/*****************************************************
+ *                FONCTIONS CANDIDATS                *
+ *****************************************************/
+
+/** 
+ * \fn void afficherCandidats(candidat_grille *grille_candidat, int num_ligne, int num_colonne)
+ * \brief Affiche les candidats d une case
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * 
+ * Cette fonction affiche les candidats d une case en parcourant
+ * les bits a 1 du masque de candidats de la case.
+*/
+void afficherCandidats(candidat_grille *grille_candidat, int num_ligne, int num_colonne) {
+    tMasque candidats = grille_candidat->candidats[num_ligne][num_colonne];
+    while (candidats != 0) {
+        printf("%d ", __builtin_ctzll(candidats) + 1);
+        candidats &= candidats - 1;
+    }
+    printf("\n");
+}
+
+/**
+ * \fn void ajouterCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur)
+ * \brief Ajoute un candidat a une case
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur a ajouter aux candidats de la case
+ * 
+ * Cette fonction met a 1 le bit de la valeur dans le masque de la case.
+ * Ajouter une valeur deja candidate n a aucun effet.
+*/
+void ajouterCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur) {
+    grille_candidat->candidats[num_ligne][num_colonne] |= BIT(valeur);
+}
+
+/**
+ * \fn void retirerCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur)
+ * \brief Retire un candidat d une case
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur a retirer des candidats de la case
+ * 
+ * Cette fonction met a 0 le bit de la valeur dans le masque de la case.
+ * Une case remplie n a plus de candidats, la retirer n a donc aucun effet.
+ * Avec l instrumentation, un candidat effectivement retire est compte pour la
+ * technique en cours.
+*/
+void retirerCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur) {
+    COMPTER(if (grille_candidat->candidats[num_ligne][num_colonne] & BIT(valeur)) {
+                grille_candidat->compteurs.eliminations[grille_candidat->compteurs.technique]++;
+            })
+    grille_candidat->candidats[num_ligne][num_colonne] &= (tMasque)~BIT(valeur);
+}
+
+/**
+ * \fn bool estCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur)
+ * \brief Verifie si une valeur est un candidat d une case
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur dont on veut verifier si elle est un candidat de la case
+ * 
+ * \return true si la valeur est un candidat de la case, false sinon
+*/
+bool estCandidat(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur) {
+    return (grille_candidat->candidats[num_ligne][num_colonne] & BIT(valeur)) != 0;
+}
+
+/**
+ * \fn int nbCandidats(candidat_grille *grille_candidat, int num_ligne, int num_colonne)
+ * \brief Retourne le nombre de candidats d une case
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * 
+ * \return Nombre de candidats de la case (nombre de bits a 1 de son masque)
+*/
+int nbCandidats(candidat_grille *grille_candidat, int num_ligne, int num_colonne) {
+    return __builtin_popcountll(grille_candidat->candidats[num_ligne][num_colonne]);
+}
+
+
+/**
+ * \fn void initGrilleCandidat(candidat_grille *grille_candidat, tGrille grille)
+ * \brief Initialise la grille de candidats
+ * \param grille_candidat Grille de candidats
+ * \param grille Grille de jeu
+ * 
+ * Cette fonction initialise la grille de candidats en copiant la grille de jeu
+ * dans la grille de candidats et en vidant le masque de candidats de chaque case.
+*/
+void initGrilleCandidat(candidat_grille *grille_candidat, tGrille grille) {
+    for (int i = 0; i < TAILLE; i++) {
+        for (int j = 0; j < TAILLE; j++) {
+            grille_candidat->valeurs[i][j] = grille[i][j];
+            grille_candidat->candidats[i][j] = 0;
+        }
+    }
+}
+
+/**
+ * \fn bool possible(candidat_grille *grille, int numLigne, int numColonne, int valeur)
+ * \brief Verifie si une valeur peut etre inseree dans une case
+ * \param grille Grille de jeu
+ * \param numLigne Numero de la ligne de la case selectionnee
+ * \param numColonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur a inserer dans la case selectionnee
+ * 
+ * \return true si la valeur peut etre inseree, false sinon
+ * 
+ * Cette fonction verifie si la valeur peut etre inseree dans la case
+ * selectionnee en verifiant si la valeur n est pas deja presente dans
+ * la ligne, la colonne, le bloc ou une unite de la variante de la case
+ * selectionnee (ses voisins).
+*/
+bool possible(candidat_grille *grille, int numLigne, int numColonne, int valeur) {
+    unsigned char *valeurs = &grille->valeurs[0][0];
+    int k = numLigne*TAILLE + numColonne;
+    bool possible = (valeurs[k] != valeur);
+
+    // check ligne, colonne, region et unites de la variante, chaque voisin une seule fois
+    for (int t = topologie.debutVoisins[k]; t < topologie.debutVoisins[k + 1] && possible; t++) {
+        possible = (valeurs[topologie.voisins[t]] != valeur);
+    }
+    return possible;
+}
+
+/**
+ * \fn void initCandidat(candidat_grille *grille_candidat)
+ * \brief Initialise les candidats de chaque case de la grille.
+ * \param grille_candidat Grille de candidats
+ * 
+ * Cette fonction calcule d abord le masque des valeurs placees dans chaque ligne,
+ * colonne et bloc, en un seul parcours de la grille. Les candidats d une case vide
+ * sont les valeurs absentes de ses trois masques (ce que verifierait possible pour
+ * chaque valeur) : ils sont calcules NB_VOIES cases d une ligne a la fois quand les
+ * blocs sont carres, case par case pour des regions irregulieres. Les valeurs placees
+ * dans chaque unite de la variante sont ensuite retirees de ses cases.
+ * Les cases remplies n ont pas de candidat.
+*/
+void initCandidat(candidat_grille *grille_candidat) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque *masques = &grille_candidat->candidats[0][0];
+    tMasque lignes[TAILLE] = {0};
+    tMasque colonnes[TAILLE] = {0};
+    tMasque blocs[TAILLE] = {0};
+    tMasque interdites[TAILLE];
+    tVecteur candidats;
+    tMasque bit, placees;
+    const short *cases;
+
+    for (int i = 0; i < TAILLE; i++) {
+        for (int j = 0; j < TAILLE; j++) {
+            if (grille_candidat->valeurs[i][j] != 0) {
+                bit = BIT(grille_candidat->valeurs[i][j]);
+                lignes[i] |= bit;
+                colonnes[j] |= bit;
+                blocs[numeroBloc(i, j)] |= bit;
+            }
+        }
+    }
+
+    for (int bande = 0; bande < n && topologie.blocsCarres; bande++) {
+        // valeurs interdites par la colonne et le bloc, pour chaque colonne de la bande
+        for (int j = 0; j < TAILLE; j++) {
+            interdites[j] = colonnes[j] | blocs[bande*n + j/n];
+        }
+        for (int i = bande*n; i < bande*n + n; i++) {
+            for (int j = 0; j < TAILLE; j += NB_VOIES) {
+                candidats = ~(chargerVecteur(&interdites[j], VOIES(j)) | lignes[i])
+                          & TOUTES_VALEURS & vecteurVides(grille_candidat, i, j);
+                rangerVecteur(&grille_candidat->candidats[i][j], candidats, VOIES(j));
+            }
+        }
+    }
+    for (int i = 0; i < TAILLE && !topologie.blocsCarres; i++) {
+        for (int j = 0; j < TAILLE; j++) {
+            grille_candidat->candidats[i][j] = (grille_candidat->valeurs[i][j] != 0) ? 0
+                : (tMasque)~(lignes[i] | colonnes[j] | blocs[numeroBloc(i, j)]) & TOUTES_VALEURS;
+        }
+    }
+
+    for (int u = 3*TAILLE; u < topologie.nbUnites; u++) {
+        cases = topologie.cases[u];
+        placees = 0;
+        for (int t = 0; t < TAILLE; t++) {
+            if (valeurs[cases[t]] != 0) {
+                placees |= BIT(valeurs[cases[t]]);
+            }
+        }
+        for (int t = 0; t < TAILLE; t++) {
+            masques[cases[t]] &= (tMasque)~placees;
+        }
+    }
+}
+
+/**
+ * \fn void retirerCandidatListe(candidat_grille *grille_candidat, const short *cases, int nbCases, int valeur)
+ * \brief Retire un candidat d une liste de cases de la topologie
+ * \param grille_candidat Grille de candidats
+ * \param cases Numeros des cases (ligne*TAILLE + colonne) : une unite ou les voisins d une case
+ * \param nbCases Nombre de cases de la liste
+ * \param valeur Valeur a retirer
+*/
+static inline void retirerCandidatListe(candidat_grille *grille_candidat, const short *cases, int nbCases, int valeur) {
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tMasque bit = BIT(valeur);
+
+    for (int t = 0; t < nbCases; t++) {
+        COMPTER(if (candidats[cases[t]] & bit) {
+                    grille_candidat->compteurs.eliminations[grille_candidat->compteurs.technique]++;
+                })
+        candidats[cases[t]] &= (tMasque)~bit;
+    }
+}
+
+/**
+ * \fn void retirerCandidatLigne(candidat_grille *grille_candidat, int num_ligne, int valeur)
+ * \brief Retire un candidat d une ligne
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param valeur Valeur a inserer dans la case selectionnee
+ * 
+ * Cette fonction retire la valeur des candidats de toutes les cases
+ * de la ligne de la case selectionnee.
+*/
+void retirerCandidatLigne(candidat_grille *grille_candidat, int num_ligne, int valeur) {
+    retirerCandidatListe(grille_candidat, topologie.cases[num_ligne], TAILLE, valeur);
+}
+
+/**
+ * \fn void retirerCandidatColonne(candidat_grille *grille_candidat, int num_colonne, int valeur)
+ * \brief Retire un candidat d une colonne
+ * \param grille_candidat Grille de candidats
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur a inserer dans la case selectionnee
+ * 
+ * Cette fonction retire la valeur des candidats de toutes les cases
+ * de la colonne de la case selectionnee.
+*/
+void retirerCandidatColonne(candidat_grille *grille_candidat, int num_colonne, int valeur) {
+    retirerCandidatListe(grille_candidat, topologie.cases[TAILLE + num_colonne], TAILLE, valeur);
+}
+
+/**
+ * \fn void retirerCandidatRegion(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur)
+ * \brief Retire un candidat d une region
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur a inserer dans la case selectionnee
+ * 
+ * Cette fonction retire la valeur des candidats de toutes les cases
+ * de la region de la case selectionnee.
+*/
+void retirerCandidatRegion(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur) {
+    retirerCandidatListe(grille_candidat, topologie.cases[topologie.unites[num_ligne*TAILLE + num_colonne][2]],
+                         TAILLE, valeur);
+}
+
+/**
+ * \fn void retirerCandidatVariante(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur)
+ * \brief Retire un candidat des unites de la variante d une case
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * \param valeur Valeur a inserer dans la case selectionnee
+ * 
+ * Cette fonction retire la valeur des candidats de toutes les cases des diagonales
+ * et de la fenetre de la case selectionnee, sans rien faire pour une grille classique.
+*/
+void retirerCandidatVariante(candidat_grille *grille_candidat, int num_ligne, int num_colonne, int valeur) {
+    int k = num_ligne*TAILLE + num_colonne;
+
+    for (int d = 3; d < topologie.nbUnitesCase[k]; d++) {
+        retirerCandidatListe(grille_candidat, topologie.cases[topologie.unites[k][d]], TAILLE, valeur);
+    }
+}
+
+/**
+ * \fn bool checkSingletonNu(candidat_grille *grille_candidat)
+ * \brief Verifie si une case a un seul candidat
+ * \param grille_candidat Grille de candidats
+ * 
+ * \return true si il y a eu au moins un singleton, false sinon
+ * 
+ * Cette fonction passe à travers chaque case de la grille de candidats.
+ * 
+ * Elle verifie si une case a un seul candidat en verifiant
+ * si le nombre de candidats de la case est egal a 1.
+ * Si c est le cas, la fonction affecte la valeur du candidat a la case
+ * et retire le candidat des candidats de ses voisins.
+*/
+bool checkSingletonNu(candidat_grille *grille_candidat) {
+    bool action_effectuee = false;
+    int valeur, k;
+    for (int i = 0; i < TAILLE; i++) {
+        for (int j = 0; j < TAILLE; j++) {
+            if ((grille_candidat->valeurs[i][j] == 0) && (nbCandidats(grille_candidat, i, j) == 1)) {
+                action_effectuee = true;
+                valeur = __builtin_ctzll(grille_candidat->candidats[i][j]) + 1;
+
+                // printf("Singleton nu (%d) trouve dans la case (%d, %d)\n", valeur, i+1, j+1);
+
+                grille_candidat->valeurs[i][j] = valeur;
+                grille_candidat->candidats[i][j] = 0;
+                COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_SINGLETON_NU;
+                        grille_candidat->compteurs.placements[TECHNIQUE_SINGLETON_NU]++);
+                TRACER(TRACE_SINGLETON, TECHNIQUE_SINGLETON_NU, i*TAILLE + j, valeur);
+
+                k = i*TAILLE + j;
+                retirerCandidatListe(grille_candidat, &topologie.voisins[topologie.debutVoisins[k]],
+                                     topologie.debutVoisins[k + 1] - topologie.debutVoisins[k], valeur);
+            }
+        }
+    }
+    return action_effectuee;
+}
+
+/**
+ * \fn void checkSingletonCacheeRegion(candidat_grille *grille_candidat, int num_unite, bool *action_effectuee)
+ * \brief Verifie si une case a un seul candidat dans sa region, ou dans une unite de la variante
+ * \param grille_candidat Grille de candidats
+ * \param num_unite Numero de l unite, comme pour caseUnite (2*TAILLE + numero de region,
+ * ou une diagonale ou une fenetre)
+ * \param action_effectuee Pointeur vers un booleen qui indique si une action a ete effectuee
+ * 
+ * Cette fonction verifie si un candidat n apparait que dans une seule case de la region
+ * en accumulant les masques des cases : un candidat deja vu une fois passe dans les
+ * candidats vus plusieurs fois.
+ * Si c est le cas, la fonction affecte la valeur du candidat a la case
+ * et retire le candidat des autres unites de la case.
+*/
+void checkSingletonCacheeRegion(candidat_grille *grille_candidat, int num_unite, bool *action_effectuee) {
+    const short *cases = topologie.cases[num_unite];
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    tMasque vuesUneFois = 0;
+    tMasque vuesPlusieurs = 0;
+    int k;
+
+    // candidats vus une fois et plusieurs fois dans la region
+    for (int t = 0; t < TAILLE; t++) {
+        vuesPlusieurs |= vuesUneFois & candidats[cases[t]];
+        vuesUneFois |= candidats[cases[t]];
+    }
+
+    // check si un candidat n apparait qu une seule fois dans la region
+    for (int i = 0; i < TAILLE; i++) {
+        if ((vuesUneFois & (tMasque)~vuesPlusieurs) & BIT(i+1)) {
+            *action_effectuee = true;
+            // printf("Singleton cachee (%d) trouve dans la region (%d, %d)\n", i+1, num_ligne+1, num_colonne+1);
+            // cherche la case qui contient le candidat
+            for (int t = 0; t < TAILLE; t++) {
+                k = cases[t];
+                if (candidats[k] & BIT(i+1)) {
+                    valeurs[k] = i+1;
+                    candidats[k] = 0;
+                    COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_CACHEE_REGION;
+                            grille_candidat->compteurs.placements[TECHNIQUE_CACHEE_REGION]++);
+                    TRACER(TRACE_SINGLETON, TECHNIQUE_CACHEE_REGION, k, i+1);
+
+                    for (int d = 0; d < topologie.nbUnitesCase[k]; d++) {
+                        if (topologie.unites[k][d] != num_unite) {
+                            retirerCandidatListe(grille_candidat, topologie.cases[topologie.unites[k][d]], TAILLE, i+1);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \fn void checkSingletonCacheeLigne(candidat_grille *grille_candidat, int num_ligne, bool *action_effectuee)
+ * \brief Verifie si une case a un seul candidat dans sa ligne
+ * \param grille_candidat Grille de candidats
+ * \param num_ligne Numero de la ligne de la case selectionnee
+ * \param action_effectuee Pointeur vers un booleen qui indique si une action a ete effectuee
+ * 
+ * Cette fonction verifie si un candidat n apparait que dans une seule case de la ligne
+ * en accumulant les masques des cases : un candidat deja vu une fois passe dans les
+ * candidats vus plusieurs fois.
+ * Si c est le cas, la fonction affecte la valeur du candidat a la case
+ * et retire le candidat de la liste des candidats de la case.
+*/
+void checkSingletonCacheeLigne(candidat_grille *grille_candidat, int num_ligne, bool *action_effectuee) {
+    tMasque vuesUneFois = 0;
+    tMasque vuesPlusieurs = 0;
+
+    // candidats vus une fois et plusieurs fois dans la ligne
+    for (int i = 0; i < TAILLE; i++) {
+        vuesPlusieurs |= vuesUneFois & grille_candidat->candidats[num_ligne][i];
+        vuesUneFois |= grille_candidat->candidats[num_ligne][i];
+    }
+
+    // check si un candidat n apparait qu une seule fois dans la ligne
+    for (int i = 0; i < TAILLE; i++) {
+        if ((vuesUneFois & (tMasque)~vuesPlusieurs) & BIT(i+1)) {
+            *action_effectuee = true;
+            // printf("Singleton cachee (%d) trouvee dans la ligne %d\n", i+1, num_ligne+1);
+            // cherche la case qui contient le candidat
+            for (int j = 0; j < TAILLE; j++) {
+                if (estCandidat(grille_candidat, num_ligne, j, i+1)) {
+                    grille_candidat->valeurs[num_ligne][j] = i+1;
+                    grille_candidat->candidats[num_ligne][j] = 0;
+                    COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_CACHEE_LIGNE;
+                            grille_candidat->compteurs.placements[TECHNIQUE_CACHEE_LIGNE]++);
+                    TRACER(TRACE_SINGLETON, TECHNIQUE_CACHEE_LIGNE, num_ligne*TAILLE + j, i+1);
+
+                    retirerCandidatColonne(grille_candidat, j, i+1);
+                    retirerCandidatRegion(grille_candidat, num_ligne, j, i+1);
+                    retirerCandidatVariante(grille_candidat, num_ligne, j, i+1);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \fn void checkSingletonCacheeColonne(candidat_grille *grille_candidat, int num_colonne, bool *action_effectuee)
+ * \brief Verifie si une case a un seul candidat dans sa colonne
+ * \param grille_candidat Grille de candidats
+ * \param num_colonne Numero de la colonne de la case selectionnee
+ * \param action_effectuee Pointeur vers un booleen qui indique si une action a ete effectuee
+ * 
+ * Cette fonction verifie si un candidat n apparait que dans une seule case de la colonne
+ * en accumulant les masques des cases : un candidat deja vu une fois passe dans les
+ * candidats vus plusieurs fois.
+ * Si c est le cas, la fonction affecte la valeur du candidat a la case
+ * et retire le candidat de la liste des candidats de la case.
+*/
+void checkSingletonCacheeColonne(candidat_grille *grille_candidat, int num_colonne, bool *action_effectuee) {
+    tMasque vuesUneFois = 0;
+    tMasque vuesPlusieurs = 0;
+
+    // candidats vus une fois et plusieurs fois dans la colonne
+    for (int i = 0; i < TAILLE; i++) {
+        vuesPlusieurs |= vuesUneFois & grille_candidat->candidats[i][num_colonne];
+        vuesUneFois |= grille_candidat->candidats[i][num_colonne];
+    }
+
+    // check si un candidat n apparait qu une seule fois dans la colonne
+    for (int i = 0; i < TAILLE; i++) {
+        if ((vuesUneFois & (tMasque)~vuesPlusieurs) & BIT(i+1)) {
+            *action_effectuee = true;
+            // printf("Singleton cachee (%d) trouvee dans la colonne %d\n", i+1, num_colonne+1);
+            // cherche la case qui contient le candidat
+            for (int j = 0; j < TAILLE; j++) {
+                if (estCandidat(grille_candidat, j, num_colonne, i+1)) {
+                    grille_candidat->valeurs[j][num_colonne] = i+1;
+                    grille_candidat->candidats[j][num_colonne] = 0;
+                    COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_CACHEE_COLONNE;
+                            grille_candidat->compteurs.placements[TECHNIQUE_CACHEE_COLONNE]++);
+                    TRACER(TRACE_SINGLETON, TECHNIQUE_CACHEE_COLONNE, j*TAILLE + num_colonne, i+1);
+
+                    retirerCandidatLigne(grille_candidat, j, i+1);
+                    retirerCandidatRegion(grille_candidat, j, num_colonne, i+1);
+                    retirerCandidatVariante(grille_candidat, j, num_colonne, i+1);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \fn bool checkSingletonCachee(candidat_grille *grille_candidat)
+ * \brief Verifie si une case a un seul candidat dans sa ligne, colonne, region ou unite de la variante
+ * \param grille_candidat Grille de candidats
+ * 
+ * \return true si il y a eu au moins un singleton cachee, false sinon
+ * 
+ * Les colonnes et les blocs sans singleton cache sont ecartes d un coup par
+ * cachesColonnes et cachesBlocs, recalcules apres chaque case remplie : seules
+ * les unites qui en ont un sont examinees par checkSingletonCachee*. Les regions
+ * irregulieres et les unites de la variante sont toutes examinees.
+*/
+bool checkSingletonCachee(candidat_grille *grille_candidat) {
+    bool action_effectuee = false;
+    bool modifiee = true;
+    bool trouve;
+    tMasque caches[TAILLE];
+
+    for (int i = 0; i < TAILLE; i++) {
+        checkSingletonCacheeLigne(grille_candidat, i, &action_effectuee);
+    }
+    for (int i = 0; i < TAILLE; i++) {
+        if (modifiee) {
+            cachesColonnes(grille_candidat, caches);
+            modifiee = false;
+        }
+        if (caches[i] != 0) {
+            trouve = false;
+            checkSingletonCacheeColonne(grille_candidat, i, &trouve);
+            modifiee = trouve;
+            action_effectuee = action_effectuee || trouve;
+        }
+    }
+    // check regions
+    modifiee = true;
+    for (int b = 0; b < TAILLE; b++) {
+        if (modifiee && topologie.blocsCarres) {
+            cachesBlocs(grille_candidat, caches);
+            modifiee = false;
+        }
+        if (!topologie.blocsCarres || caches[b] != 0) {
+            trouve = false;
+            checkSingletonCacheeRegion(grille_candidat, 2*TAILLE + b, &trouve);
+            modifiee = trouve;
+            action_effectuee = action_effectuee || trouve;
+        }
+    }
+    // check diagonales et fenetres
+    for (int u = 3*TAILLE; u < topologie.nbUnites; u++) {
+        checkSingletonCacheeRegion(grille_candidat, u, &action_effectuee);
+    }
+    return action_effectuee;
+}
+
+/*****************************************************
+ *              RESOLUTION PAR PAQUETS               *
+ *****************************************************/
+
+/**
+ * \struct tPaquet
+ * \brief Candidats de TAILLE_PAQUET grilles, coupes en tranches
+ * 
+ * candidats[k][v] a le bit g a 1 si la valeur v+1 est encore candidate dans la case k
+ * de la grille g. Une case remplie garde sa valeur pour seul candidat : toutes les
+ * cases de toutes les grilles sont ainsi traitees par les memes instructions.
+ * uniques[k] a le bit g a 1 si la case k de la grille g n a qu un candidat.
+*/
+typedef struct {
+    tTranche candidats[TAILLE*TAILLE][TAILLE];
+    tTranche uniques[TAILLE*TAILLE];
+} tPaquet;
+
+/**
+ * \fn void reduirePaquet(int **grilles, int nbGrilles, tEtatPaquet *etats, void **travail)
+ * \brief Place les singletons nus et caches de plusieurs grilles a la fois
+ * \param grilles Cases de chaque grille ligne par ligne, completees par les valeurs deduites
+ * \param nbGrilles Nombre de grilles, au plus TAILLE_PAQUET
+ * \param etats Etat de chaque grille a la fin de la reduction
+ * \param travail Etat de reduction de l appelant (tPaquet), alloue au premier appel
+ * et libere par l appelant avec free
+ * 
+ * Chaque passe traite toutes les grilles en meme temps, une tranche par operation :
+ * - les cases a un seul candidat sont reperees en accumulant leurs candidats vus
+ *   une fois et plusieurs fois ;
+ * - dans chaque unite (caseUnite, comme retirerCandidatLigne, retirerCandidatColonne
+ *   et retirerCandidatRegion), la valeur d une case a un seul candidat est retiree
+ *   des autres cases ;
+ * - dans chaque unite, une valeur candidate dans une seule case y est inscrite.
+ * Les passes continuent tant qu une grille encore coherente perd des candidats.
+ * Une grille est sans solution si une case n a plus de candidat, si une valeur n a
+ * plus de place dans une unite, ou si deux cases d une unite ont la meme valeur.
+ * 
+ * Si la memoire manque, les grilles sont rendues telles quelles a la recherche.
+*/
+void reduirePaquet(int **grilles, int nbGrilles, tEtatPaquet *etats, void **travail) {
+    tPaquet *paquet = *travail;
+    tTranche (*candidats)[TAILLE];
+    tTranche *uniques;
+    tTranche fixeesUneFois[TAILLE], fixeesPlusieurs[TAILLE];
+    tTranche vuesUneFois, vuesPlusieurs, fixee, caches, garder, retire, change, bit;
+    tTranche echec = {0};
+    int k, u, t, v, w, g;
+    bool complete;
+
+    if (paquet == NULL) {
+        pthread_once(&topologieCalculee, initTopologie);
+        // les tranches AVX2 demandent un alignement de 32 octets, plus que celui de malloc
+        paquet = aligned_alloc(_Alignof(tTranche), sizeof(tPaquet));
+        *travail = paquet;
+    }
+    if (paquet == NULL) {
+        for (g = 0; g < nbGrilles; g++) {
+            etats[g] = PAQUET_A_CHERCHER;
+        }
+        return;
+    }
+    candidats = paquet->candidats;
+    uniques = paquet->uniques;
+
+    // chargement : les bits des grilles absentes restent a 0, elles sont en echec des la premiere passe
+    memset(candidats, 0, sizeof(paquet->candidats));
+    for (g = 0; g < nbGrilles; g++) {
+        bit = (tTranche) {0};
+        bit[g / 64] = 1ULL << (g % 64);
+        for (k = 0; k < TAILLE*TAILLE; k++) {
+            if (grilles[g][k] != 0) {
+                candidats[k][grilles[g][k] - 1] |= bit;
+            } else {
+                for (v = 0; v < TAILLE; v++) {
+                    candidats[k][v] |= bit;
+                }
+            }
+        }
+    }
+
+    do {
+        change = (tTranche) {0};
+
+        // singletons nus : cases a un seul candidat
+        for (k = 0; k < TAILLE*TAILLE; k++) {
+            vuesUneFois = (tTranche) {0};
+            vuesPlusieurs = (tTranche) {0};
+            for (v = 0; v < TAILLE; v++) {
+                vuesPlusieurs |= vuesUneFois & candidats[k][v];
+                vuesUneFois |= candidats[k][v];
+            }
+            uniques[k] = vuesUneFois & ~vuesPlusieurs;
+            echec |= ~vuesUneFois;
+        }
+
+        // retrait des valeurs fixees dans chaque unite
+        for (u = 0; u < topologie.nbUnites; u++) {
+            for (v = 0; v < TAILLE; v++) {
+                fixeesUneFois[v] = (tTranche) {0};
+                fixeesPlusieurs[v] = (tTranche) {0};
+            }
+            for (t = 0; t < TAILLE; t++) {
+                k = caseUnite(u, t);
+                for (v = 0; v < TAILLE; v++) {
+                    fixee = candidats[k][v] & uniques[k];
+                    fixeesPlusieurs[v] |= fixeesUneFois[v] & fixee;
+                    fixeesUneFois[v] |= fixee;
+                }
+            }
+            for (t = 0; t < TAILLE; t++) {
+                k = caseUnite(u, t);
+                for (v = 0; v < TAILLE; v++) {
+                    retire = candidats[k][v] & fixeesUneFois[v] & ~uniques[k];
+                    candidats[k][v] &= ~retire;
+                    change |= retire;
+                }
+            }
+            for (v = 0; v < TAILLE; v++) {
+                echec |= fixeesPlusieurs[v];
+            }
+        }
+
+        // singletons caches : valeurs candidates dans une seule case de l unite
+        for (u = 0; u < topologie.nbUnites; u++) {
+            for (v = 0; v < TAILLE; v++) {
+                vuesUneFois = (tTranche) {0};
+                vuesPlusieurs = (tTranche) {0};
+                for (t = 0; t < TAILLE; t++) {
+                    k = caseUnite(u, t);
+                    vuesPlusieurs |= vuesUneFois & candidats[k][v];
+                    vuesUneFois |= candidats[k][v];
+                }
+                echec |= ~vuesUneFois;
+                caches = vuesUneFois & ~vuesPlusieurs;
+                for (t = 0; t < TAILLE && !trancheVide(caches); t++) {
+                    k = caseUnite(u, t);
+                    garder = candidats[k][v] & caches & ~uniques[k];
+                    if (!trancheVide(garder)) {
+                        for (w = 0; w < TAILLE; w++) {
+                            retire = (w == v) ? (tTranche) {0} : candidats[k][w] & garder;
+                            candidats[k][w] &= ~retire;
+                            change |= retire;
+                        }
+                    }
+                    caches &= ~candidats[k][v];
+                }
+            }
+        }
+    } while (!trancheVide(change & ~echec));
+
+    // les uniques de la derniere passe sont a jour pour les grilles coherentes
+    for (g = 0; g < nbGrilles; g++) {
+        complete = true;
+        for (k = 0; k < TAILLE*TAILLE && !bitTranche(echec, g); k++) {
+            if (bitTranche(uniques[k], g)) {
+                v = 0;
+                while (!bitTranche(candidats[k][v], g)) {
+                    v++;
+                }
+                grilles[g][k] = v + 1;
+            } else {
+                complete = false;
+            }
+        }
+        etats[g] = bitTranche(echec, g) ? PAQUET_SANS_SOLUTION
+                 : complete ? PAQUET_RESOLUE : PAQUET_A_CHERCHER;
+    }
+}
+
+/*****************************************************
+ *                   POINT D ENTREE                  *
+ *****************************************************/
+
+/**
+ * \fn bool donneesCoherentes(candidat_grille *grille_candidat)
+ * \brief Verifie qu aucune valeur n est donnee deux fois dans une ligne, une colonne, un bloc
+ * ou une unite de la variante
+ * \param grille_candidat Grille de jeu
+ * 
+ * \return true si les cases remplies ne se contredisent pas, false sinon
+ * 
+ * Les candidats des cases vides ne tiennent compte que des valeurs placees : sans
+ * cette verification, une grille dont deux cases donnees se contredisent serait
+ * parcourue entierement avant d etre declaree sans solution.
+*/
+bool donneesCoherentes(candidat_grille *grille_candidat) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque lignes[TAILLE] = {0};
+    tMasque colonnes[TAILLE] = {0};
+    tMasque blocs[TAILLE] = {0};
+    tMasque bit, placees;
+    const short *cases;
+    int b;
+
+    for (int i = 0; i < TAILLE; i++) {
+        for (int j = 0; j < TAILLE; j++) {
+            if (grille_candidat->valeurs[i][j] != 0) {
+                bit = BIT(grille_candidat->valeurs[i][j]);
+                b = numeroBloc(i, j);
+                if ((lignes[i] | colonnes[j] | blocs[b]) & bit) {
+                    return false;
+                }
+                lignes[i] |= bit;
+                colonnes[j] |= bit;
+                blocs[b] |= bit;
+            }
+        }
+    }
+    for (int u = 3*TAILLE; u < topologie.nbUnites; u++) {
+        cases = topologie.cases[u];
+        placees = 0;
+        for (int t = 0; t < TAILLE; t++) {
+            if (valeurs[cases[t]] != 0) {
+                bit = BIT(valeurs[cases[t]]);
+                if (placees & bit) {
+                    return false;
+                }
+                placees |= bit;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn bool placerSingletons(candidat_grille *grille_candidat, tPile *pile, int *cases, bool balayage)
+ * \brief Initialise la grille de candidats et y place les singletons, avant la recherche
+ * \param grille_candidat Grille de candidats a initialiser
+ * \param pile Pile dont la file de travail sert a la propagation
+ * \param cases Valeurs des cases ligne par ligne (0 pour une case vide)
+ * \param balayage true pour chercher les singletons par balayage complet de la grille
+ * (checkSingletonNu et checkSingletonCachee), false pour les propager par file de travail
+ * 
+ * \return false si les cases donnees se contredisent ou si la propagation trouve
+ * une contradiction, true sinon
+ * 
+ * Les compteurs de l instrumentation sont remis a zero ici, au debut de chaque resolution.
+*/
+bool placerSingletons(candidat_grille *grille_candidat, tPile *pile, int *cases, bool balayage) {
+    bool coherente;
+
+    COMPTER(double debut = tempsEcoule();
+            memset(&grille_candidat->compteurs, 0, sizeof(tCompteurs));
+            for (int k = 0; k < TAILLE*TAILLE; k++) {
+                grille_candidat->compteurs.casesVides += (cases[k] == 0);
+            })
+    initGrilleCandidat(grille_candidat, (int (*)[TAILLE]) cases);
+    if (!donneesCoherentes(grille_candidat)) {
+        return false;
+    }
+    initCandidat(grille_candidat);
+    pile->hauteurPiste = 0;
+    pile->essaisPalier = 0;
+    pile->succesPalier = 0;
+    pile->nbNoeuds = 0;
+
+    bool action_effectuee = true;
+    bool tmp = true;
+    bool end_of_game = false;
+
+    if (balayage) {
+        while (end_of_game != true) {
+            tmp = checkSingletonNu(grille_candidat);
+            if (!tmp)
+                action_effectuee = false;
+            while (tmp) {
+                action_effectuee = true;
+                tmp = checkSingletonNu(grille_candidat);
+            }
+            if (!action_effectuee) {
+                tmp = checkSingletonCachee(grille_candidat);
+                if (!tmp)
+                    end_of_game = true;
+                while (tmp) {
+                    action_effectuee = true;
+                    tmp = checkSingletonCachee(grille_candidat);
+                }
+            }
+        }
+        coherente = true;
+    } else {
+        pile->propagation = true;
+        enfilerTout(&pile->file);
+        coherente = propagerSingletons(grille_candidat, pile);
+    }
+    COMPTER(for (int t = 0; t < NB_TECHNIQUES; t++) {
+                grille_candidat->compteurs.casesLogique += grille_candidat->compteurs.placements[t];
+            }
+            grille_candidat->compteurs.tempsLogique = tempsEcoule() - debut);
+    return coherente;
+}
+
+/**
+ * \fn bool resoudre(int *cases, tMoteur moteur, bool balayage, unsigned etages, void **travail, tDonneur *donneur)
+ * \brief Resout une grille de TAILLE*TAILLE cases
+ * \param cases Valeurs des cases ligne par ligne (0 pour une case vide),
+ * remplacees par la solution si la grille est resolue
+ * \param moteur Moteur de recherche utilise apres les singletons
+ * \param balayage true pour chercher les singletons par balayage complet de la grille
+ * (checkSingletonNu et checkSingletonCachee), false pour les propager par file de travail
+ * \param etages Drapeaux tEtage des etages appliques par la propagation apres les singletons
+ * \param travail Etat de resolution de l appelant (tTravail) : s il vaut NULL, il est
+ * alloue et doit etre libere par l appelant avec free
+ * \param donneur Thread de la resolution a plusieurs d une meme grille, ou NULL :
+ * la recherche s arrete quand un autre thread a repondu (donneur->arret), et la
+ * recherche iterative donne ses branches aux threads inactifs (donneur->profondeurMax)
+ * 
+ * \return true si la grille est resolue, false si elle n a pas de solution
+ * (ou si l etat de resolution n a pas pu etre alloue)
+ * 
+ * La fonction est reentrante : deux threads peuvent l appeler en meme temps
+ * avec des etats de resolution differents.
+*/
+bool resoudre(int *cases, tMoteur moteur, bool balayage, unsigned etages, void **travail, tDonneur *donneur) {
+    tContraintes contraintes;
+    bool resolue;
+
+    // la piste est trop grosse pour la pile d execution, elle est allouee une fois par appelant
+    if (*travail == NULL) {
+        pthread_once(&topologieCalculee, initTopologie);
+        *travail = malloc(sizeof(tTravail));
+        if (*travail == NULL) {
+            return false;
+        }
+    }
+    candidat_grille *grille_candidat = &((tTravail *) *travail)->grille_candidat;
+    tPile *pile = &((tTravail *) *travail)->pile;
+
+    pile->donneur = donneur;
+    pile->etages = etages;
+    pile->depart = cases;
+    pile->limite = 1;
+    pile->premiere = NULL;
+    pile->rappel = NULL;
+
+    resolue = placerSingletons(grille_candidat, pile, cases, balayage);
+    COMPTER(double debut = tempsEcoule());
+
+    if (!resolue) {
+        // contradiction detectee par les singletons, inutile de chercher
+    } else if (moteur == MOTEUR_ITERATIF) {
+        resolue = rechercheIterative(grille_candidat, pile, false);
+    } else if (moteur == MOTEUR_MAC) {
+        resolue = rechercheIterative(grille_candidat, pile, true);
+    } else if (moteur == MOTEUR_MRV) {
+        initContraintes(&contraintes, grille_candidat);
+        contraintes.arret = (donneur != NULL) ? donneur->arret : NULL;
+        resolue = backtrackingMRV(grille_candidat, &contraintes);
+        pile->nbNoeuds = contraintes.nbNoeuds;
+    } else {
+        initContraintes(&contraintes, grille_candidat);
+        contraintes.arret = (donneur != NULL) ? donneur->arret : NULL;
+        resolue = backtracking(grille_candidat, &contraintes, premiereCaseVide(grille_candidat));
+        pile->nbNoeuds = contraintes.nbNoeuds;
+    }
+    COMPTER(grille_candidat->compteurs.tempsRecherche = tempsEcoule() - debut);
+
+    if (resolue) {
+        for (int i = 0; i < TAILLE; i++) {
+            for (int j = 0; j < TAILLE; j++) {
+                cases[i*TAILLE + j] = grille_candidat->valeurs[i][j];
+            }
+        }
+    }
+    return resolue;
+}
+
+/**
+ * \fn long compterSolutions(int *cases, tMoteur moteur, bool balayage, unsigned etages, long limite, void **travail)
+ * \brief Compte les solutions d une grille de TAILLE*TAILLE cases, jusqu a une limite
+ * \param cases Valeurs des cases ligne par ligne (0 pour une case vide),
+ * remplacees par la premiere solution trouvee s il y en a une
+ * \param moteur MOTEUR_ITERATIF pour une recherche sans propagation, la recherche
+ * iterative avec propagation (MOTEUR_MAC) sinon
+ * \param balayage true pour chercher les singletons par balayage avant la recherche
+ * \param etages Drapeaux tEtage des etages appliques par la propagation apres les singletons
+ * \param limite Nombre de solutions au-dela duquel il est inutile de chercher
+ * (2 pour savoir si la solution est unique)
+ * \param travail Etat de resolution de l appelant, comme pour resoudre
+ * 
+ * \return Nombre de solutions trouvees, au plus limite
+ * 
+ * La recherche est celle de resoudre : les singletons et la propagation elaguent
+ * l arbre de la meme facon, seule la fin de la recherche change. Avec une limite
+ * de 2, verifier l unicite coute donc la resolution plus le parcours de ce qu il
+ * reste de l arbre apres la premiere solution.
+*/
+long compterSolutions(int *cases, tMoteur moteur, bool balayage, unsigned etages, long limite, void **travail) {
+    if (*travail == NULL) {
+        pthread_once(&topologieCalculee, initTopologie);
+        *travail = malloc(sizeof(tTravail));
+        if (*travail == NULL) {
+            return 0;
+        }
+    }
+    candidat_grille *grille_candidat = &((tTravail *) *travail)->grille_candidat;
+    tPile *pile = &((tTravail *) *travail)->pile;
+
+    pile->donneur = NULL;
+    pile->etages = etages;
+    pile->depart = cases;
+    pile->limite = limite;
+    pile->premiere = cases;
+    pile->rappel = NULL;
+
+    if (!placerSingletons(grille_candidat, pile, cases, balayage)) {
+        return 0;
+    }
+    COMPTER(double debut = tempsEcoule());
+    rechercheIterative(grille_candidat, pile, moteur != MOTEUR_ITERATIF);
+    COMPTER(grille_candidat->compteurs.tempsRecherche = tempsEcoule() - debut);
+    return pile->nbSolutions;
+}
+
+/**
+ * \fn long enumererSolutions(int *cases, tMoteur moteur, bool balayage, unsigned etages, long limite, tRappelSolution rappel, void *contexte, void **travail)
+ * \brief Passe les solutions d une grille une a une a une fonction, jusqu a une limite
+ * \param cases Valeurs des cases ligne par ligne (0 pour une case vide), inchangees
+ * \param moteur MOTEUR_ITERATIF pour une recherche sans propagation, la recherche
+ * iterative avec propagation (MOTEUR_MAC) sinon
+ * \param balayage true pour chercher les singletons par balayage avant la recherche
+ * \param etages Drapeaux tEtage des etages appliques par la propagation apres les singletons
+ * \param limite Nombre de solutions apres lequel l enumeration s arrete
+ * \param rappel Fonction appelee pour chaque solution, avec ses TAILLE*TAILLE cases
+ * ligne par ligne : elle rend false pour arreter l enumeration
+ * \param contexte Donnees de l appelant, passees a rappel
+ * \param travail Etat de resolution de l appelant, comme pour resoudre
+ * 
+ * \return Nombre de solutions passees a rappel
+ * 
+ * Les solutions ne sont jamais gardees : rappel recoit les cases de la grille de
+ * travail, valables jusqu a son retour, et la recherche reprend ensuite la ou elle
+ * en etait. La memoire utilisee ne depend donc pas du nombre de solutions.
+*/
+long enumererSolutions(int *cases, tMoteur moteur, bool balayage, unsigned etages, long limite, tRappelSolution rappel, void *contexte, void **travail) {
+    if (*travail == NULL) {
+        pthread_once(&topologieCalculee, initTopologie);
+        *travail = malloc(sizeof(tTravail));
+        if (*travail == NULL) {
+            return 0;
+        }
+    }
+    candidat_grille *grille_candidat = &((tTravail *) *travail)->grille_candidat;
+    tPile *pile = &((tTravail *) *travail)->pile;
+
+    pile->donneur = NULL;
+    pile->etages = etages;
+    pile->depart = cases;
+    pile->limite = limite;
+    pile->premiere = NULL;
+    pile->rappel = rappel;
+    pile->contexte = contexte;
+
+    if (!placerSingletons(grille_candidat, pile, cases, balayage)) {
+        return 0;
+    }
+    COMPTER(double debut = tempsEcoule());
+    rechercheIterative(grille_candidat, pile, moteur != MOTEUR_ITERATIF);
+    COMPTER(grille_candidat->compteurs.tempsRecherche = tempsEcoule() - debut);
+    return pile->nbSolutions;
+}
+
+/**
+ * \fn long denombrerSymetrique(candidat_grille *grille_candidat, tPile *pile, tMasque absentes, long limite)
+ * \brief Compte les solutions a partir de l etat courant, en regroupant les valeurs interchangeables
+ * \param grille_candidat Grille de candidats, singletons propages
+ * \param pile Pile dont la piste recoit les choix, annules avant le retour
+ * \param absentes Valeurs placees dans aucune case : chaque case vide les a toutes
+ * pour candidates, ou aucune
+ * \param limite Nombre de solutions au-dela duquel il est inutile de compter
+ * 
+ * \return Nombre de solutions, au plus limite
+ * 
+ * Echanger deux valeurs absentes transforme une solution en une autre solution. Les
+ * solutions ou une case recoit une valeur absente se repartissent donc en autant de
+ * groupes de meme taille qu il y a de valeurs absentes. On branche sur la case la plus
+ * contrainte parmi celles qui acceptent les valeurs absentes : chacune de ses valeurs
+ * placees est essayee, mais une seule valeur absente, dont le compte est multiplie par
+ * le nombre de valeurs absentes. Quand il en reste moins de deux, la recherche
+ * iterative compte les solutions restantes sans les recopier.
+*/
+long denombrerSymetrique(candidat_grille *grille_candidat, tPile *pile, tMasque absentes, long limite) {
+    unsigned char *valeurs = &grille_candidat->valeurs[0][0];
+    tMasque *candidats = &grille_candidat->candidats[0][0];
+    int marque = pile->hauteurPiste;
+    int nbAbsentes = __builtin_popcountll(absentes);
+    int k, nb, val;
+    int numCase = -1;
+    int meilleurNb = TAILLE + 1;
+    long total = 0;
+    long compte;
+    tMasque essais, bit;
+
+    if (nbAbsentes < 2) {
+        pile->limite = limite;
+        rechercheIterative(grille_candidat, pile, true);
+        annulerPiste(grille_candidat, pile, marque);
+        return pile->nbSolutions;
+    }
+
+    for (k = 0; k < TAILLE*TAILLE; k++) {
+        if (valeurs[k] == 0 && (candidats[k] & absentes) != 0) {
+            nb = __builtin_popcountll(candidats[k]);
+            if (nb < meilleurNb) {
+                numCase = k;
+                meilleurNb = nb;
+            }
+        }
+    }
+    if (numCase == -1) {
+        // Les valeurs absentes n'ont plus de place
+        return 0;
+    }
+
+    // les valeurs placees de la case, puis la plus petite valeur absente
+    essais = (candidats[numCase] & (tMasque)~absentes) | (absentes & (tMasque)-absentes);
+    while (essais != 0 && total < limite) {
+        val = __builtin_ctzll(essais) + 1;
+        bit = BIT(val);
+        essais &= essais - 1;
+        pile->nbNoeuds++;
+        COMPTER(grille_candidat->compteurs.technique = TECHNIQUE_CHOIX);
+        TRACER(TRACE_CHOIX, 0, numCase, val);
+
+        if (inscrireValeur(grille_candidat, pile, numCase, val) && propagerSingletons(grille_candidat, pile)) {
+            if (absentes & bit) {
+                compte = denombrerSymetrique(grille_candidat, pile, absentes & (tMasque)~bit,
+                                             (limite - total - 1) / nbAbsentes + 1);
+                compte = (compte > (limite - total) / nbAbsentes) ? limite - total : compte * nbAbsentes;
+            } else {
+                compte = denombrerSymetrique(grille_candidat, pile, absentes, limite - total);
+            }
+            total += compte;
+        } else {
+            viderFile(&pile->file);
+            COMPTER(grille_candidat->compteurs.retours++);
+        }
+        annulerPiste(grille_candidat, pile, marque);
+        TRACER(TRACE_RETOUR, 0, 0, 0);
+    }
+    return total;
+}
+
+/**
+ * \fn long denombrerSolutions(int *cases, bool balayage, unsigned etages, long limite, void **travail)
+ * \brief Compte les solutions d une grille sans les construire, jusqu a une limite
+ * \param cases Valeurs des cases ligne par ligne (0 pour une case vide), inchangees
+ * \param balayage true pour chercher les singletons par balayage avant la recherche
+ * \param etages Drapeaux tEtage des etages appliques par la propagation apres les singletons
+ * \param limite Nombre de solutions au-dela duquel il est inutile de compter
+ * \param travail Etat de resolution de l appelant, comme pour resoudre
+ * 
+ * \return Nombre de solutions, au plus limite
+ * 
+ * La recherche est celle de MOTEUR_MAC, sans rappel ni recopie des solutions, et les
+ * valeurs qui n apparaissent pas dans la grille sont comptees ensemble
+ * (denombrerSymetrique) : une grille vide de 4x4 ne demande que 12 des 288 solutions.
+*/
+long denombrerSolutions(int *cases, bool balayage, unsigned etages, long limite, void **travail) {
+    unsigned char *valeurs;
+    tMasque *candidats;
+    tMasque absentes = TOUTES_VALEURS;
+
+    if (*travail == NULL) {
+        pthread_once(&topologieCalculee, initTopologie);
+        *travail = malloc(sizeof(tTravail));
+        if (*travail == NULL) {
+            return 0;
+        }
+    }
+    candidat_grille *grille_candidat = &((tTravail *) *travail)->grille_candidat;
+    tPile *pile = &((tTravail *) *travail)->pile;
+
+    pile->donneur = NULL;
+    pile->etages = etages;
+    pile->depart = cases;
+    pile->premiere = NULL;
+    pile->rappel = NULL;
+
+    if (!placerSingletons(grille_candidat, pile, cases, balayage)) {
+        return 0;
+    }
+    COMPTER(double debut = tempsEcoule());
+    pile->propagation = true;
+    enfilerTout(&pile->file);
+    if (!propagerSingletons(grille_candidat, pile)) {
+        return 0;
+    }
+
+    valeurs = &grille_candidat->valeurs[0][0];
+    candidats = &grille_candidat->candidats[0][0];
+    for (int k = 0; k < TAILLE*TAILLE; k++) {
+        if (valeurs[k] != 0) {
+            absentes &= (tMasque)~BIT(valeurs[k]);
+        }
+    }
+    for (int k = 0; k < TAILLE*TAILLE; k++) {
+        if (valeurs[k] == 0 && (candidats[k] & absentes) != 0 && (candidats[k] & absentes) != absentes) {
+            // apres un balayage sur une grille contradictoire, les valeurs absentes
+            // peuvent ne plus etre interchangeables : on les compte une a une
+            absentes = 0;
+        }
+    }
+    long total = denombrerSymetrique(grille_candidat, pile, absentes, limite);
+    COMPTER(grille_candidat->compteurs.tempsRecherche = tempsEcoule() - debut);
+    return total;
+}
+
+/**
+ * \fn long noeudsExplores(void *travail)
+ * \brief Nombre de valeurs essayees par la derniere recherche faite avec un etat de resolution
+ * \param travail Etat de resolution passe a resoudre (ou aux autres points d entree), ou NULL
+ * 
+ * \return Nombre de noeuds de l arbre de recherche, 0 si aucune recherche n a ete faite
+ * 
+ * Un noeud est une valeur inscrite par un choix : les singletons deduits ensuite ne
+ * comptent pas. Le nombre de noeuds ne depend pas de la machine, ce qui permet de
+ * comparer les moteurs independamment de leur vitesse.
+*/
+long noeudsExplores(void *travail) {
+    return travail == NULL ? 0 : ((tTravail *) travail)->pile.nbNoeuds;
+}
+
+#ifdef INSTRUMENTATION
+/**
+ * \fn const tCompteurs *lireCompteurs(void *travail)
+ * \brief Compteurs de la derniere resolution faite avec un etat de resolution
+ * \param travail Etat de resolution passe a resoudre (ou aux autres points d entree), ou NULL
+ * 
+ * \return Compteurs de l etat de resolution, valables jusqu a la resolution suivante,
+ * NULL si aucune resolution n a ete faite
+*/
+const tCompteurs *lireCompteurs(void *travail) {
+    return travail == NULL ? NULL : &((tTravail *) travail)->grille_candidat.compteurs;
+}
+#endif
+
+/*****************************************************
+ *                    FIN DU NOYAU                   *
+ *****************************************************/
+
+#undef tMasque
+#undef candidat_grille
+#undef tGrille
+#undef tContraintes
+#undef tModification
+#undef tChoix
+#undef tFile
+#undef tPile
+#undef tTravail
+#undef tVecteur
+#undef tOctets
+#undef chargerVecteur
+#undef rangerVecteur
+#undef vecteurVides
+#undef cachesColonnes
+#undef cachesBlocs
+#undef tPaquet
+#undef reduirePaquet
+#undef tFamille
+#undef tSegment
+#undef tTopologie
+#undef topologie
+#undef topologieCalculee
+#undef initTopologie
+#undef numeroBloc
+#undef initContraintes
+#undef valeursAutorisees
+#undef placerValeur
+#undef enleverValeur
+#undef backtracking
+#undef caseMoinsContrainte
+#undef backtrackingMRV
+#undef caseUnite
+#undef enfiler
+#undef enfilerCase
+#undef enfilerTout
+#undef viderFile
+#undef inscrireValeur
+#undef propagerSingletons
+#undef retirerCandidats
+#undef eliminerBloques
+#undef chercherSousEnsemble
+#undef eliminerSousEnsembles
+#undef positionsValeurs
+#undef chercherPoisson
+#undef eliminerPoissons
+#undef eliminerColoriage
+#undef palierRentable
+#undef appliquerPalier
+#undef appliquerEtages
+#undef annulerPiste
+#undef rechercheIterative
+#undef premiereCaseVide
+#undef donnerChoix
+#undef afficherCandidats
+#undef ajouterCandidat
+#undef retirerCandidat
+#undef retirerCandidatListe
+#undef estCandidat
+#undef nbCandidats
+#undef initGrilleCandidat
+#undef possible
+#undef initCandidat
+#undef retirerCandidatLigne
+#undef retirerCandidatColonne
+#undef retirerCandidatRegion
+#undef retirerCandidatVariante
+#undef checkSingletonNu
+#undef checkSingletonCacheeRegion
+#undef checkSingletonCacheeLigne
+#undef checkSingletonCacheeColonne
+#undef checkSingletonCachee
+#undef donneesCoherentes
+#undef placerSingletons
+#undef resoudre
+#undef compterSolutions
+#undef enumererSolutions
+#undef denombrerSymetrique
+#undef denombrerSolutions
+#undef noeudsExplores
+#undef lireCompteurs
+
+#undef TAILLE
+#undef TOUTES_VALEURS
+#undef BIT
+#undef NB_VOIES
+#undef VOIES
+#undef CAPACITE_FILE
+#undef POISSON_MAX
+#undef NB_FENETRES
+#undef UNITES_MAX
+#undef VOISINS_MAX
+#undef FAMILLES_MAX
+#undef SEGMENTS_MAX
+#undef NOYAU
+#undef NOYAU_CONCAT
+#undef NOYAU_CONCAT_
+#undef n
\ No newline at end of file
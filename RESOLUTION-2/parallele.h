@@ -0,0 +1,268 @@
+/**
+ * \file parallele.h
+ * \brief Execution de taches sur plusieurs threads avec vol de travail
+ * \author PFRANGER Matheo, FAUCHET Malo
+ * \date 16 Octobre 2026
+ * \version 1.0
+ *
+ * Chaque travailleur a sa propre deque de taches : il prend ses taches par le bas,
+ * et quand sa deque est vide il vole les taches des autres par le haut. Une tache
+ * est un simple numero, interprete par la fonction de traitement, qui peut elle-meme
+ * deposer de nouvelles taches. Le pool s arrete quand toutes les taches deposees
+ * sont terminees.
+ *
+ * Inclus par RESOLUTION-2.c, qui doit definir _GNU_SOURCE (pour l epinglage des threads).
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+/**
+ * \struct tDeque
+ * \brief Deque de taches d un travailleur, protegee par un verrou
+ *
+ * Les taches en attente sont taches[haut] a taches[bas-1].
+*/
+typedef struct {
+    int *taches;
+    int capacite;
+    int haut;                   // prochaine tache a voler
+    int bas;                    // place de la prochaine tache deposee
+    pthread_mutex_t verrou;
+} tDeque;
+
+typedef struct tPool tPool;
+
+/**
+ * \typedef tTraitement
+ * \brief Fonction executee pour chaque tache par le travailleur numTravailleur
+*/
+typedef void (*tTraitement)(tPool *pool, int numTravailleur, int tache);
+
+/**
+ * \struct tPool
+ * \brief Ensemble de travailleurs partageant des taches
+*/
+struct tPool {
+    int nbTravailleurs;
+    tDeque *deques;             // une deque par travailleur
+    tTraitement traitement;
+    void *contexte;             // donnees de l appelant, lues par traitement
+    atomic_int enCours;         // taches deposees et pas encore terminees
+    atomic_int inactifs;        // travailleurs qui cherchent une tache sans en trouver
+    bool epingler;              // fixe chaque travailleur sur un coeur
+};
+
+/**
+ * \struct tTravailleur
+ * \brief Argument d un thread du pool
+*/
+typedef struct {
+    tPool *pool;
+    int numero;
+} tTravailleur;
+
+// Parallel functions
+int nombreCoeurs(void);
+bool deposerTache(tPool *pool, int numTravailleur, int tache);
+bool prendreTache(tDeque *deque, bool voler, int *tache);
+void *travailleur(void *argument);
+void executerPool(int nbTaches, int nbTravailleurs, bool epingler, tTraitement traitement, void *contexte);
+
+/**
+ * \fn int nombreCoeurs(void)
+ * \brief Determine le nombre de coeurs disponibles
+ *
+ * \return Nombre de coeurs en ligne, au moins 1
+*/
+int nombreCoeurs(void) {
+    long nb = sysconf(_SC_NPROCESSORS_ONLN);
+    return nb < 1 ? 1 : (int) nb;
+}
+
+/**
+ * \fn bool deposerTache(tPool *pool, int numTravailleur, int tache)
+ * \brief Ajoute une tache en bas de la deque d un travailleur
+ * \param pool Pool de travailleurs
+ * \param numTravailleur Numero du travailleur qui recoit la tache
+ * \param tache Numero de la tache
+ *
+ * \return true si la tache est deposee, false si la memoire manque
+*/
+bool deposerTache(tPool *pool, int numTravailleur, int tache) {
+    tDeque *deque = &pool->deques[numTravailleur];
+    int *nouveau;
+    bool depose = true;
+
+    pthread_mutex_lock(&deque->verrou);
+    if (deque->bas == deque->capacite) {
+        if (deque->haut > 0) {
+            // les taches volees ont libere le debut du tableau
+            memmove(deque->taches, deque->taches + deque->haut, (deque->bas - deque->haut) * sizeof(int));
+            deque->bas -= deque->haut;
+            deque->haut = 0;
+        } else {
+            nouveau = realloc(deque->taches, 2 * deque->capacite * sizeof(int));
+            if (nouveau == NULL) {
+                depose = false;
+            } else {
+                deque->taches = nouveau;
+                deque->capacite *= 2;
+            }
+        }
+    }
+    if (depose) {
+        deque->taches[deque->bas] = tache;
+        deque->bas++;
+        atomic_fetch_add(&pool->enCours, 1);
+    }
+    pthread_mutex_unlock(&deque->verrou);
+    return depose;
+}
+
+/**
+ * \fn bool prendreTache(tDeque *deque, bool voler, int *tache)
+ * \brief Retire une tache d une deque
+ * \param deque Deque a vider
+ * \param voler false pour prendre la derniere tache deposee (proprietaire de la deque),
+ * true pour prendre la plus ancienne (autre travailleur)
+ * \param tache Tache retiree
+ *
+ * \return true si une tache a ete retiree, false si la deque est vide
+*/
+bool prendreTache(tDeque *deque, bool voler, int *tache) {
+    bool prise = false;
+
+    pthread_mutex_lock(&deque->verrou);
+    if (deque->haut < deque->bas) {
+        if (voler) {
+            *tache = deque->taches[deque->haut];
+            deque->haut++;
+        } else {
+            deque->bas--;
+            *tache = deque->taches[deque->bas];
+        }
+        prise = true;
+    }
+    pthread_mutex_unlock(&deque->verrou);
+    return prise;
+}
+
+/**
+ * \fn void *travailleur(void *argument)
+ * \brief Boucle d un travailleur : traite ses taches, puis vole celles des autres
+ * \param argument Travailleur (tTravailleur)
+ *
+ * \return NULL
+*/
+void *travailleur(void *argument) {
+    tPool *pool = ((tTravailleur *) argument)->pool;
+    int numero = ((tTravailleur *) argument)->numero;
+    int tache;
+    bool trouvee;
+    bool inactif = false;
+
+    if (pool->epingler) {
+        cpu_set_t coeurs;
+        CPU_ZERO(&coeurs);
+        CPU_SET(numero % nombreCoeurs(), &coeurs);
+        pthread_setaffinity_np(pthread_self(), sizeof(coeurs), &coeurs);
+    }
+
+    while (atomic_load(&pool->enCours) > 0) {
+        trouvee = prendreTache(&pool->deques[numero], false, &tache);
+        for (int i = 1; i < pool->nbTravailleurs && !trouvee; i++) {
+            trouvee = prendreTache(&pool->deques[(numero + i) % pool->nbTravailleurs], true, &tache);
+        }
+        if (trouvee) {
+            if (inactif) {
+                atomic_fetch_sub(&pool->inactifs, 1);
+                inactif = false;
+            }
+            pool->traitement(pool, numero, tache);
+            atomic_fetch_sub(&pool->enCours, 1);
+        } else {
+            // les taches restantes sont en cours chez les autres, qui peuvent encore en deposer :
+            // inactifs leur signale qu ils peuvent en donner
+            if (!inactif) {
+                atomic_fetch_add(&pool->inactifs, 1);
+                inactif = true;
+            }
+            sched_yield();
+        }
+    }
+    if (inactif) {
+        atomic_fetch_sub(&pool->inactifs, 1);
+    }
+    return NULL;
+}
+
+/**
+ * \fn void executerPool(int nbTaches, int nbTravailleurs, bool epingler, tTraitement traitement, void *contexte)
+ * \brief Execute les taches 0 a nbTaches-1 sur nbTravailleurs threads
+ * \param nbTaches Nombre de taches initiales
+ * \param nbTravailleurs Nombre de threads, le thread appelant compris
+ * \param epingler true pour fixer chaque travailleur sur un coeur
+ * \param traitement Fonction executee pour chaque tache
+ * \param contexte Donnees de l appelant, accessibles par pool->contexte
+ *
+ * Les taches initiales sont reparties par blocs contigus entre les deques.
+ * La fonction rend la main quand toutes les taches, y compris celles deposees
+ * pendant l execution, sont terminees. Un travailleur qui ne peut pas etre
+ * cree laisse ses taches aux autres.
+*/
+void executerPool(int nbTaches, int nbTravailleurs, bool epingler, tTraitement traitement, void *contexte) {
+    tPool pool;
+    pthread_t *threads = malloc(nbTravailleurs * sizeof(pthread_t));
+    tTravailleur *travailleurs = malloc(nbTravailleurs * sizeof(tTravailleur));
+    bool *lance = calloc(nbTravailleurs, sizeof(bool));
+    int capacite = nbTaches / nbTravailleurs + 1;
+
+    pool.nbTravailleurs = nbTravailleurs;
+    pool.deques = malloc(nbTravailleurs * sizeof(tDeque));
+    pool.traitement = traitement;
+    pool.contexte = contexte;
+    pool.epingler = epingler;
+    atomic_init(&pool.enCours, 0);
+    atomic_init(&pool.inactifs, 0);
+
+    for (int i = 0; i < nbTravailleurs; i++) {
+        pool.deques[i].taches = malloc(capacite * sizeof(int));
+        pool.deques[i].capacite = capacite;
+        pool.deques[i].haut = 0;
+        pool.deques[i].bas = 0;
+        pthread_mutex_init(&pool.deques[i].verrou, NULL);
+    }
+    // le travailleur i recoit les taches [i*nbTaches/nb, (i+1)*nbTaches/nb[ : la derniere
+    // deposee, prise en premier, est a la fin de son bloc, et les voleurs prennent au debut
+    for (int i = 0; i < nbTravailleurs; i++) {
+        for (int t = (int)((long)i*nbTaches/nbTravailleurs); t < (int)((long)(i+1)*nbTaches/nbTravailleurs); t++) {
+            deposerTache(&pool, i, t);
+        }
+    }
+
+    // le thread appelant est le travailleur 0
+    for (int i = 0; i < nbTravailleurs; i++) {
+        travailleurs[i].pool = &pool;
+        travailleurs[i].numero = i;
+        if (i > 0) {
+            lance[i] = (pthread_create(&threads[i], NULL, travailleur, &travailleurs[i]) == 0);
+        }
+    }
+    travailleur(&travailleurs[0]);
+    for (int i = 1; i < nbTravailleurs; i++) {
+        if (lance[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    for (int i = 0; i < nbTravailleurs; i++) {
+        pthread_mutex_destroy(&pool.deques[i].verrou);
+        free(pool.deques[i].taches);
+    }
+    free(pool.deques);
+    free(lance);
+    free(travailleurs);
+    free(threads);
+}
\ No newline at end of file
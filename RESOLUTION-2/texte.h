@@ -0,0 +1,410 @@
+/**
+ * \file texte.h
+ * \brief Lecture rapide de grilles ecrites en texte
+ * \author PFRANGER Matheo, FAUCHET Malo
+ * \date 16 Octobre 2026
+ * \version 1.0
+ *
+ * Deux formats sont reconnus, et peuvent etre melanges dans un meme texte :
+ * - une grille par ligne : les TAILLE*TAILLE cases a la suite ;
+ * - une grille sur TAILLE lignes : une ligne par rangee de la grille.
+ * Dans une ligne, les cases sont soit un caractere chacune ('.' ou '0' pour une case
+ * vide, '1' a '9', puis 'A' a 'Z' pour 10 a 35, en majuscule ou minuscule), soit des
+ * nombres separes par des espaces, des virgules ou des points-virgules, ce qui permet
+ * toutes les tailles de grille. Les '|' et '+' sont ignores, ainsi que les lignes faites
+ * seulement de '-', '+', '|' et '=' et la fin des lignes a partir de '#'. Une ligne vide
+ * ou un titre ("Grid 01") separe deux grilles : il ne doit pas couper une grille.
+ *
+ * Une ligne de 16 cases commence une grille 16x16 sur 16 lignes, sauf si -n 2
+ * impose des grilles 4x4, ecrites alors sur une ligne.
+ *
+ * Inclus par RESOLUTION-2.c, apres la definition de N_MIN et N_MAX.
+*/
+
+#include <ctype.h>
+
+/**
+ * \def CASE_ERRONEE
+ * \brief Valeur d un caractere qui ne peut pas etre une case
+*/
+#define CASE_ERRONEE 0xFF
+
+/**
+ * \def CASE_IGNOREE
+ * \brief Valeur d un caractere saute entre deux cases ('|' et '+')
+*/
+#define CASE_IGNOREE 0xFE
+
+/**
+ * \def CASE_SEPARATEUR
+ * \brief Valeur d un caractere separant deux nombres (' ', tabulation, ',' et ';')
+*/
+#define CASE_SEPARATEUR 0xFD
+
+/**
+ * \struct tGrilleTexte
+ * \brief Grille trouvee dans un texte
+*/
+typedef struct {
+    long debut;         // rang de la premiere case dans tTexte.cases
+    int tailleBloc;
+    int ligne;          // numero de sa premiere ligne dans le texte, a partir de 1
+} tGrilleTexte;
+
+/**
+ * \struct tTexte
+ * \brief Grilles lues dans un texte, cases bout a bout
+ *
+ * Chaque case occupe un octet (TAILLE vaut au plus 64) : le tableau des cases est
+ * quatre fois plus petit que des entiers, et se remplit d autant plus vite.
+*/
+typedef struct {
+    unsigned char *cases;
+    long nbCases;
+    long capaciteCases;
+    tGrilleTexte *grilles;
+    int nbGrilles;
+    int capaciteGrilles;
+    int erreurs;        // lignes mal formees et grilles incompletes
+} tTexte;
+
+// Text functions
+bool estTexte(const char *donnees, size_t taille);
+void initialiserSymboles(unsigned char symboles[256]);
+bool estTitre(const unsigned char *ligne, const unsigned char *fin);
+int lireLigne(const unsigned char *ligne, const unsigned char *fin, const unsigned char symboles[256],
+              unsigned char *cases, int maxCases, int *maximum);
+bool reserverCases(tTexte *lu, long nbCases);
+bool ajouterGrilleTexte(tTexte *lu, long debut, int tailleBloc, int ligne);
+bool lireTexte(const char *donnees, size_t taille, int tailleBlocImposee, const char *nom, tTexte *lu);
+
+/**
+ * \fn bool estTexte(const char *donnees, size_t taille)
+ * \brief Distingue un texte d un fichier .sud binaire
+ * \param donnees Contenu du fichier
+ * \param taille Taille du contenu en octets
+ *
+ * \return true si le contenu ne contient aucun octet nul : chaque entier d un fichier
+ * .sud en contient au moins deux, alors qu un texte n en contient jamais
+*/
+bool estTexte(const char *donnees, size_t taille) {
+    return memchr(donnees, '\0', taille) == NULL;
+}
+
+/**
+ * \fn void initialiserSymboles(unsigned char symboles[256])
+ * \brief Remplit la table de valeur des caracteres d une ligne de cases
+ * \param symboles Table a remplir, indicee par le caractere
+*/
+void initialiserSymboles(unsigned char symboles[256]) {
+    memset(symboles, CASE_ERRONEE, 256);
+    symboles['.'] = 0;
+    symboles['|'] = CASE_IGNOREE;
+    symboles['+'] = CASE_IGNOREE;
+    symboles[' '] = CASE_SEPARATEUR;
+    symboles['\t'] = CASE_SEPARATEUR;
+    symboles[','] = CASE_SEPARATEUR;
+    symboles[';'] = CASE_SEPARATEUR;
+    for (int c = '0'; c <= '9'; c++) {
+        symboles[c] = (unsigned char) (c - '0');
+    }
+    for (int c = 'A'; c <= 'Z'; c++) {
+        symboles[c] = (unsigned char) (c - 'A' + 10);
+        symboles[c - 'A' + 'a'] = (unsigned char) (c - 'A' + 10);
+    }
+}
+
+/**
+ * \fn bool estTitre(const unsigned char *ligne, const unsigned char *fin)
+ * \brief Reconnait une ligne de titre entre deux grilles, par exemple "Grid 01"
+ * \param ligne Premier caractere de la ligne
+ * \param fin Caractere qui suit la ligne
+ *
+ * \return true si la ligne commence par deux lettres et contient un espace ou ':',
+ * ce qui n arrive ni a une rangee d un caractere par case, ni a une rangee de nombres
+*/
+bool estTitre(const unsigned char *ligne, const unsigned char *fin) {
+    const unsigned char *c = ligne;
+    bool lettres;
+
+    while (c < fin && (*c == ' ' || *c == '\t')) {
+        c++;
+    }
+    lettres = (fin - c >= 2 && isalpha(c[0]) && isalpha(c[1]));
+    return lettres && (memchr(c, ' ', fin - c) != NULL || memchr(c, '\t', fin - c) != NULL
+                       || memchr(c, ':', fin - c) != NULL);
+}
+
+/**
+ * \fn int lireLigne(const unsigned char *ligne, const unsigned char *fin, const unsigned char symboles[256], unsigned char *cases, int maxCases, int *maximum)
+ * \brief Lit les cases d une ligne de texte
+ * \param ligne Premier caractere de la ligne
+ * \param fin Caractere qui suit la ligne (fin de ligne ou '#')
+ * \param symboles Table de initialiserSymboles
+ * \param cases Destination des cases lues
+ * \param maxCases Nombre maximum de cases a lire
+ * \param maximum Plus grande valeur lue
+ *
+ * \return Nombre de cases de la ligne, ou -1 si un caractere ou un nombre ne peut pas
+ * etre une case, ou si la ligne a plus de maxCases cases
+ *
+ * La ligne est d abord lue comme un caractere par case, en une seule passe : c est le
+ * format des grilles sur une ligne, le plus courant dans les gros fichiers. Au premier
+ * separateur, elle est relue comme une suite de nombres.
+*/
+int lireLigne(const unsigned char *ligne, const unsigned char *fin, const unsigned char symboles[256],
+              unsigned char *cases, int maxCases, int *maximum) {
+    const unsigned char *c;
+    int nbCases = 0;
+    int valeur;
+    int plusGrande = 0;
+
+    // un caractere par case
+    for (c = ligne; c < fin; c++) {
+        valeur = symboles[*c];
+        if (valeur >= CASE_SEPARATEUR) {
+            if (valeur == CASE_IGNOREE) {
+                continue;
+            }
+            if (valeur == CASE_ERRONEE) {
+                return -1;
+            }
+            break;
+        }
+        if (nbCases == maxCases) {
+            return -1;
+        }
+        plusGrande = valeur > plusGrande ? valeur : plusGrande;
+        cases[nbCases++] = (unsigned char) valeur;
+    }
+    if (c == fin) {
+        *maximum = plusGrande;
+        return nbCases;
+    }
+
+    // des nombres (ou des caracteres seuls) separes
+    nbCases = 0;
+    plusGrande = 0;
+    c = ligne;
+    while (c < fin) {
+        if (symboles[*c] == CASE_SEPARATEUR || symboles[*c] == CASE_IGNOREE) {
+            c++;
+            continue;
+        }
+        if (nbCases == maxCases) {
+            return -1;
+        }
+        if (*c >= '0' && *c <= '9') {
+            valeur = 0;
+            while (c < fin && *c >= '0' && *c <= '9' && valeur <= N_MAX*N_MAX) {
+                valeur = 10*valeur + (*c - '0');
+                c++;
+            }
+        } else {
+            valeur = symboles[*c];
+            c++;
+        }
+        if (valeur > N_MAX*N_MAX || (c < fin && symboles[*c] != CASE_SEPARATEUR && symboles[*c] != CASE_IGNOREE)) {
+            return -1;
+        }
+        plusGrande = valeur > plusGrande ? valeur : plusGrande;
+        cases[nbCases++] = (unsigned char) valeur;
+    }
+    *maximum = plusGrande;
+    return nbCases;
+}
+
+/**
+ * \fn bool reserverCases(tTexte *lu, long nbCases)
+ * \brief Agrandit si besoin le tableau des cases lues
+ * \param lu Grilles lues
+ * \param nbCases Nombre de cases a pouvoir ajouter
+ *
+ * \return true si la place est reservee, false si la memoire manque
+*/
+bool reserverCases(tTexte *lu, long nbCases) {
+    unsigned char *nouveau;
+    long capacite = lu->capaciteCases;
+
+    if (lu->nbCases + nbCases <= capacite) {
+        return true;
+    }
+    while (lu->nbCases + nbCases > capacite) {
+        capacite = 2*capacite + 4096;
+    }
+    nouveau = realloc(lu->cases, capacite);
+    if (nouveau == NULL) {
+        return false;
+    }
+    lu->cases = nouveau;
+    lu->capaciteCases = capacite;
+    return true;
+}
+
+/**
+ * \fn bool ajouterGrilleTexte(tTexte *lu, long debut, int tailleBloc, int ligne)
+ * \brief Ajoute une grille complete aux grilles lues
+ * \param lu Grilles lues
+ * \param debut Rang de sa premiere case dans lu->cases
+ * \param tailleBloc Taille d un bloc de la grille
+ * \param ligne Numero de sa premiere ligne
+ *
+ * \return true si la grille est ajoutee, false si la memoire manque
+*/
+bool ajouterGrilleTexte(tTexte *lu, long debut, int tailleBloc, int ligne) {
+    tGrilleTexte *nouveau;
+
+    if (lu->nbGrilles == lu->capaciteGrilles) {
+        nouveau = realloc(lu->grilles, (2*lu->capaciteGrilles + 64) * sizeof(tGrilleTexte));
+        if (nouveau == NULL) {
+            return false;
+        }
+        lu->grilles = nouveau;
+        lu->capaciteGrilles = 2*lu->capaciteGrilles + 64;
+    }
+    lu->grilles[lu->nbGrilles].debut = debut;
+    lu->grilles[lu->nbGrilles].tailleBloc = tailleBloc;
+    lu->grilles[lu->nbGrilles].ligne = ligne;
+    lu->nbGrilles++;
+    return true;
+}
+
+/**
+ * \fn bool lireTexte(const char *donnees, size_t taille, int tailleBlocImposee, const char *nom, tTexte *lu)
+ * \brief Lit toutes les grilles d un texte
+ * \param donnees Texte, lu en entier
+ * \param taille Taille du texte en octets
+ * \param tailleBlocImposee Taille de bloc imposee par -n, 0 si elle est deduite de chaque grille
+ * \param nom Nom du texte, repris dans les messages d erreur
+ * \param lu Grilles lues, a liberer par l appelant (lu->cases et lu->grilles)
+ *
+ * \return false si la memoire manque, true sinon. Une ligne mal formee est signalee sur
+ * la sortie d erreur et comptee dans lu->erreurs : la grille qui la contient est
+ * abandonnee, et la lecture reprend a la ligne suivante.
+*/
+bool lireTexte(const char *donnees, size_t taille, int tailleBlocImposee, const char *nom, tTexte *lu) {
+    const unsigned char *c = (const unsigned char *) donnees;
+    const unsigned char *finTexte = c + taille;
+    const unsigned char *finLigne;
+    const unsigned char *finCases;
+    const unsigned char *d;
+    unsigned char symboles[256];
+    int numLigne = 0;
+    int nbCases;
+    // grille en cours de lecture
+    int blocEnCours = 0;
+    bool sur1Ligne = false;
+    bool vide;
+    int maximum;
+    int rangees = 0;
+    int ligneDebut = 0;
+    long debut = 0;
+
+    memset(lu, 0, sizeof(*lu));
+    initialiserSymboles(symboles);
+    // une case occupe au moins un caractere : le tableau n est jamais recopie
+    if (!reserverCases(lu, (long) taille + N_MAX*N_MAX*N_MAX*N_MAX)) {
+        return false;
+    }
+
+    for (; c < finTexte; c = finLigne + 1) {
+        numLigne++;
+        finLigne = memchr(c, '\n', finTexte - c);
+        if (finLigne == NULL) {
+            finLigne = finTexte;
+        }
+        finCases = memchr(c, '#', finLigne - c);
+        if (finCases == NULL) {
+            finCases = finLigne;
+        }
+        if (finCases > c && finCases[-1] == '\r') {
+            finCases--;
+        }
+        // ligne de separation, commentaire, ligne vide ou titre : une ligne vide ou un titre
+        // termine la grille en cours
+        vide = true;
+        for (d = c; d < finCases && (*d == ' ' || *d == '\t' || *d == '-' || *d == '+'
+                                     || *d == '|' || *d == '=' || *d == '\r'); d++) {
+            vide = vide && (*d == ' ' || *d == '\t' || *d == '\r');
+        }
+        if (d == finCases || estTitre(c, finCases)) {
+            if (blocEnCours != 0 && ((vide && finCases == finLigne) || d != finCases)) {
+                fprintf(stderr, "ERREUR. %s:%d : grille incomplete, interrompue a la ligne %d.\n",
+                        nom, ligneDebut, numLigne);
+                lu->erreurs++;
+                lu->nbCases = debut;
+                blocEnCours = 0;
+            }
+            continue;
+        }
+
+        if (!reserverCases(lu, N_MAX*N_MAX*N_MAX*N_MAX)) {
+            return false;
+        }
+        nbCases = lireLigne(c, finCases, symboles, lu->cases + lu->nbCases, N_MAX*N_MAX*N_MAX*N_MAX, &maximum);
+        if (nbCases < 0) {
+            fprintf(stderr, "ERREUR. %s:%d : ligne mal formee.\n", nom, numLigne);
+            lu->erreurs++;
+            if (blocEnCours != 0) {
+                // la grille en cours est abandonnee
+                lu->nbCases = debut;
+                blocEnCours = 0;
+            }
+            continue;
+        }
+
+        if (blocEnCours != 0 && nbCases != blocEnCours*blocEnCours) {
+            fprintf(stderr, "ERREUR. %s:%d : grille incomplete, la ligne %d n a pas %d cases.\n",
+                    nom, ligneDebut, numLigne, blocEnCours*blocEnCours);
+            lu->erreurs++;
+            lu->nbCases = debut;
+            blocEnCours = 0;
+        }
+        if (blocEnCours == 0) {
+            debut = lu->nbCases;
+            ligneDebut = numLigne;
+            sur1Ligne = false;
+            // une rangee l emporte sur une grille entiere de meme nombre de cases (16)
+            for (int k = N_MIN; k <= N_MAX && blocEnCours == 0; k++) {
+                if ((tailleBlocImposee == 0 || k == tailleBlocImposee) && nbCases == k*k) {
+                    blocEnCours = k;
+                    rangees = 0;
+                }
+            }
+            for (int k = N_MIN; k <= N_MAX && blocEnCours == 0; k++) {
+                if ((tailleBlocImposee == 0 || k == tailleBlocImposee) && nbCases == k*k*k*k) {
+                    blocEnCours = k;
+                    sur1Ligne = true;
+                }
+            }
+            if (blocEnCours == 0) {
+                fprintf(stderr, "ERREUR. %s:%d : %d cases, ce n est ni une grille ni une rangee.\n",
+                        nom, numLigne, nbCases);
+                lu->erreurs++;
+                continue;
+            }
+        }
+
+        if (maximum > blocEnCours*blocEnCours) {
+            fprintf(stderr, "ERREUR. %s:%d : valeur hors de la grille.\n", nom, numLigne);
+            lu->erreurs++;
+            lu->nbCases = debut;
+            blocEnCours = 0;
+            continue;
+        }
+        lu->nbCases += nbCases;
+
+        if (sur1Ligne || ++rangees == blocEnCours*blocEnCours) {
+            if (!ajouterGrilleTexte(lu, debut, blocEnCours, ligneDebut)) {
+                return false;
+            }
+            blocEnCours = 0;
+        }
+    }
+    if (blocEnCours != 0) {
+        fprintf(stderr, "ERREUR. %s:%d : grille incomplete a la fin du texte.\n", nom, ligneDebut);
+        lu->erreurs++;
+        lu->nbCases = debut;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,641 @@
+/**
+ * \file trace.h
+ * \brief Trace binaire de la recherche, et son analyse hors ligne
+ * \author PFRANGER Matheo, FAUCHET Malo
+ * \date 17 Octobre 2026
+ * \version 1.0
+ *
+ * Avec --trace, chaque thread note les evenements de ses resolutions dans un tampon,
+ * vide par blocs dans un fichier commun :
+ * - un en-tete de TAILLE_ENTETE_TRACE octets : "SUDT", version (2 octets), 0 (2 octets) ;
+ * - des blocs : numero du thread (4 octets), taille des evenements en octets (4 octets),
+ *   puis les evenements, dans l ordre ou le thread les a notes.
+ * Un evenement tient sur 4 octets : type sur 3 bits, technique sur 3 bits, numero de
+ * case sur 12 bits et valeur sur 7 bits, en commencant par les bits de poids faible.
+ * L evenement TRACE_GRILLE donne a la place la taille de bloc (4 bits) et la longueur
+ * du nom de la grille (25 bits) ; le nom suit, complete par des octets nuls jusqu a
+ * un multiple de 4 octets.
+ * Tous les entiers sont ecrits en petit-boutiste.
+ *
+ * La profondeur n est pas notee : chaque TRACE_RETOUR annule le dernier TRACE_CHOIX
+ * encore ouvert, ce qui suffit a reconstruire l arbre de recherche (analyserTrace).
+ *
+ * Inclus par RESOLUTION-2.c avant les noyaux, apres la definition de tTechnique.
+*/
+
+#include <stdint.h>
+
+/**
+ * \def MAGIE_TRACE
+ * \brief Premiers octets d un fichier de trace
+*/
+#define MAGIE_TRACE "SUDT"
+
+/**
+ * \def VERSION_TRACE
+ * \brief Version du format ecrit par les fonctions de trace
+*/
+#define VERSION_TRACE 1
+
+/**
+ * \def TAILLE_ENTETE_TRACE
+ * \brief Taille de l en-tete d un fichier de trace, en octets
+*/
+#define TAILLE_ENTETE_TRACE 8
+
+/**
+ * \def TAILLE_TAMPON_TRACE
+ * \brief Taille du tampon de chaque thread, en octets : un bloc du fichier au plus
+*/
+#define TAILLE_TAMPON_TRACE (1 << 16)
+
+/**
+ * \def TAILLE_NOM_TRACE
+ * \brief Longueur maximale du nom d une grille dans la trace
+*/
+#define TAILLE_NOM_TRACE 1023
+
+/**
+ * \def NB_SOUS_ARBRES
+ * \brief Nombre de sous-arbres abandonnes gardes par grille par l analyse
+*/
+#define NB_SOUS_ARBRES 10
+
+/**
+ * \def PROFONDEUR_TRACE_MAX
+ * \brief Nombre maximal de choix ouverts en meme temps : un par case de la plus grande grille
+*/
+#define PROFONDEUR_TRACE_MAX (N_MAX*N_MAX*N_MAX*N_MAX)
+
+/**
+ * \def PROFONDEUR_PILES
+ * \brief Profondeur des piles repliees : un choix plus profond est compte dans son ancetre
+ * a cette profondeur, pour que le fichier reste de la taille de l arbre de ses premiers choix
+*/
+#define PROFONDEUR_PILES 32
+
+/**
+ * \enum tEvenement
+ * \brief Type d un evenement de la trace
+*/
+typedef enum {
+    TRACE_GRILLE,       // debut de la resolution d une grille, suivi de son nom
+    TRACE_CHOIX,        // valeur essayee par la recherche dans une case
+    TRACE_RETOUR,       // la derniere valeur essayee encore ouverte a echoue
+    TRACE_SINGLETON,    // valeur deduite dans une case par une technique
+    TRACE_SOLUTION,     // la grille est remplie
+    TRACE_FIN           // fin de la resolution de la grille
+} tEvenement;
+
+/**
+ * \struct tTrace
+ * \brief Tampon de trace d un thread
+*/
+typedef struct {
+    FILE *fichier;              // fichier commun a tous les threads
+    pthread_mutex_t *verrou;    // protege fichier
+    uint32_t numero;            // numero du thread, ecrit dans chaque bloc
+    unsigned char *tampon;
+    size_t nb;                  // octets occupes dans tampon
+    bool erreur;                // une ecriture a echoue, la suite de la trace est perdue
+} tTrace;
+
+/**
+ * \var traceThread
+ * \brief Tampon de trace du thread, NULL si la recherche n est pas tracee
+ *
+ * Chaque thread a le sien : les noyaux n ont pas a le recevoir en parametre.
+*/
+_Thread_local tTrace *traceThread = NULL;
+
+/**
+ * \def TRACER
+ * \brief Note un evenement de la recherche si le thread est trace
+ *
+ * Sans trace, il ne coute qu un test sur traceThread.
+*/
+#define TRACER(type, technique, numCase, valeur)                              \
+    do {                                                                      \
+        if (__builtin_expect(traceThread != NULL, 0)) {                       \
+            tracer(traceThread, type, technique, numCase, valeur);            \
+        }                                                                     \
+    } while (0)
+
+/**
+ * \struct tCadre
+ * \brief Choix ouvert de l arbre reconstruit par l analyse
+*/
+typedef struct {
+    int numCase;
+    int valeur;
+    long debut;                 // evenements de la grille avant le choix
+    long propres;               // poids du choix dans les piles repliees : ses singletons, et ses
+                                // descendants au-dela de PROFONDEUR_PILES
+    size_t finChemin;           // longueur du chemin des piles repliees jusqu a ce choix compris
+} tCadre;
+
+/**
+ * \struct tSousArbre
+ * \brief Sous-arbre abandonne, garde par l analyse parmi les plus couteux
+*/
+typedef struct {
+    long cout;                  // choix et singletons du sous-arbre, le choix compris
+    int profondeur;
+    char *chemin;               // choix depuis la racine
+} tSousArbre;
+
+/**
+ * \struct tAnalyse
+ * \brief Etat de l analyse de la trace d un thread
+ *
+ * cadres[0] est la racine (avant tout choix), cadres[profondeur] le dernier choix ouvert.
+*/
+typedef struct {
+    bool enCours;               // une grille est commencee
+    char nom[TAILLE_NOM_TRACE + 1];
+    int tailleBloc;
+    tCadre *cadres;
+    char chemin[12*PROFONDEUR_PILES + 1];   // choix ouverts jusqu a PROFONDEUR_PILES, separes par ';'
+    int profondeur;
+    int profondeurMax;
+    long evenements;            // choix et singletons de la grille
+    long noeuds;
+    long retours;
+    long solutions;
+    long singletons[NB_TECHNIQUES];
+    long *noeudsProfondeur;     // choix a chaque profondeur (1 a la racine)
+    long *singletonsProfondeur; // singletons deduits a chaque profondeur
+    tSousArbre pires[NB_SOUS_ARBRES];
+    int nbPires;
+} tAnalyse;
+
+// Trace functions
+bool ouvrirTrace(FILE *f);
+bool initTrace(tTrace *trace, FILE *f, pthread_mutex_t *verrou, int numero);
+void viderTrace(tTrace *trace);
+void fermerTrace(tTrace *trace);
+void tracerGrille(tTrace *trace, const char *nom, int tailleBloc);
+void nommerCadres(tAnalyse *analyse, int profondeur, const char *separateur, char *dest, size_t taille);
+bool ouvrirCadre(tAnalyse *analyse, int numCase, int valeur);
+void fermerCadre(tAnalyse *analyse, FILE *piles, bool abandon);
+void terminerGrille(tAnalyse *analyse, FILE *sortie, FILE *piles);
+tAnalyse *creerAnalyse(void);
+void libererAnalyse(tAnalyse *analyse);
+int analyserTrace(FILE *f, FILE *sortie, FILE *piles);
+
+/**
+ * \fn bool ouvrirTrace(FILE *f)
+ * \brief Ecrit l en-tete d un fichier de trace
+ * \param f Fichier ouvert en ecriture binaire
+ *
+ * \return true si l en-tete est ecrit
+*/
+bool ouvrirTrace(FILE *f) {
+    unsigned char entete[TAILLE_ENTETE_TRACE] = {0};
+
+    memcpy(entete, MAGIE_TRACE, 4);
+    entete[4] = VERSION_TRACE & 0xFF;
+    entete[5] = VERSION_TRACE >> 8;
+    return fwrite(entete, 1, sizeof(entete), f) == sizeof(entete);
+}
+
+/**
+ * \fn bool initTrace(tTrace *trace, FILE *f, pthread_mutex_t *verrou, int numero)
+ * \brief Prepare le tampon de trace d un thread
+ * \param trace Tampon a preparer
+ * \param f Fichier de trace, dont l en-tete est ecrit
+ * \param verrou Verrou partage par tous les threads qui ecrivent dans f
+ * \param numero Numero du thread
+ *
+ * \return false si la memoire manque
+*/
+bool initTrace(tTrace *trace, FILE *f, pthread_mutex_t *verrou, int numero) {
+    trace->fichier = f;
+    trace->verrou = verrou;
+    trace->numero = (uint32_t) numero;
+    trace->tampon = malloc(TAILLE_TAMPON_TRACE);
+    trace->nb = 0;
+    trace->erreur = (trace->tampon == NULL);
+    return !trace->erreur;
+}
+
+/**
+ * \fn void viderTrace(tTrace *trace)
+ * \brief Ecrit le contenu du tampon dans le fichier, en un bloc
+ * \param trace Tampon du thread
+*/
+void viderTrace(tTrace *trace) {
+    unsigned char entete[8];
+
+    if (trace->nb == 0 || trace->erreur) {
+        trace->nb = 0;
+        return;
+    }
+    for (int i = 0; i < 4; i++) {
+        entete[i] = (unsigned char) (trace->numero >> (8*i));
+        entete[4 + i] = (unsigned char) (trace->nb >> (8*i));
+    }
+    pthread_mutex_lock(trace->verrou);
+    trace->erreur = fwrite(entete, 1, 8, trace->fichier) != 8
+                 || fwrite(trace->tampon, 1, trace->nb, trace->fichier) != trace->nb;
+    pthread_mutex_unlock(trace->verrou);
+    trace->nb = 0;
+}
+
+/**
+ * \fn void fermerTrace(tTrace *trace)
+ * \brief Ecrit ce qui reste dans le tampon et le libere
+ * \param trace Tampon du thread
+*/
+void fermerTrace(tTrace *trace) {
+    viderTrace(trace);
+    free(trace->tampon);
+    trace->tampon = NULL;
+}
+
+/**
+ * \fn void tracer(tTrace *trace, tEvenement type, int technique, int numCase, int valeur)
+ * \brief Ajoute un evenement au tampon du thread, vide dans le fichier quand il est plein
+ * \param trace Tampon du thread
+ * \param type Type de l evenement
+ * \param technique Technique d un TRACE_SINGLETON (tTechnique), 0 sinon
+ * \param numCase Numero de la case (ligne*TAILLE + colonne), 0 si l evenement n a pas de case
+ * \param valeur Valeur inscrite, 0 si l evenement n a pas de valeur
+*/
+static inline void tracer(tTrace *trace, tEvenement type, int technique, int numCase, int valeur) {
+    uint32_t mot = (uint32_t) type | (uint32_t) technique << 3 | (uint32_t) numCase << 6 | (uint32_t) valeur << 18;
+
+    if (trace->nb + 4 > TAILLE_TAMPON_TRACE) {
+        viderTrace(trace);
+    }
+    trace->tampon[trace->nb] = (unsigned char) mot;
+    trace->tampon[trace->nb + 1] = (unsigned char) (mot >> 8);
+    trace->tampon[trace->nb + 2] = (unsigned char) (mot >> 16);
+    trace->tampon[trace->nb + 3] = (unsigned char) (mot >> 24);
+    trace->nb += 4;
+}
+
+/**
+ * \fn void tracerGrille(tTrace *trace, const char *nom, int tailleBloc)
+ * \brief Note le debut de la resolution d une grille
+ * \param trace Tampon du thread
+ * \param nom Nom de la grille, tronque a TAILLE_NOM_TRACE octets
+ * \param tailleBloc Taille de bloc de la grille
+ *
+ * L evenement et le nom sont toujours dans le meme bloc.
+*/
+void tracerGrille(tTrace *trace, const char *nom, int tailleBloc) {
+    size_t longueur = strlen(nom);
+    size_t taille;
+
+    if (longueur > TAILLE_NOM_TRACE) {
+        longueur = TAILLE_NOM_TRACE;
+    }
+    taille = 4 + (longueur + 3) / 4 * 4;
+    if (trace->nb + taille > TAILLE_TAMPON_TRACE) {
+        viderTrace(trace);
+    }
+    tracer(trace, TRACE_GRILLE, 0, 0, 0);
+    trace->tampon[trace->nb - 4] |= (unsigned char) (tailleBloc << 3 | (longueur & 1) << 7);
+    trace->tampon[trace->nb - 3] = (unsigned char) (longueur >> 1);
+    trace->tampon[trace->nb - 2] = (unsigned char) (longueur >> 9);
+    memset(trace->tampon + trace->nb, 0, taille - 4);
+    memcpy(trace->tampon + trace->nb, nom, longueur);
+    trace->nb += taille - 4;
+}
+
+/*****************************************************
+ *                 ANALYSE DE TRACE                  *
+ *****************************************************/
+
+/**
+ * \fn void nommerCadres(tAnalyse *analyse, int profondeur, const char *separateur, char *dest, size_t taille)
+ * \brief Ecrit les choix ouverts de la racine jusqu a une profondeur, sous la forme r1c3=4
+ * \param analyse Analyse de la trace d un thread
+ * \param profondeur Dernier choix ecrit
+ * \param separateur Texte ecrit entre deux choix
+ * \param dest Destination, tronquee si elle est trop petite
+ * \param taille Taille de dest
+*/
+void nommerCadres(tAnalyse *analyse, int profondeur, const char *separateur, char *dest, size_t taille) {
+    int taille_grille = analyse->tailleBloc*analyse->tailleBloc;
+    size_t position = 0;
+    int ecrits;
+
+    dest[0] = '\0';
+    for (int p = 1; p <= profondeur && position < taille; p++) {
+        ecrits = snprintf(dest + position, taille - position, "%sr%dc%d=%d", p > 1 ? separateur : "",
+                          analyse->cadres[p].numCase / taille_grille + 1,
+                          analyse->cadres[p].numCase % taille_grille + 1, analyse->cadres[p].valeur);
+        position += (size_t) ecrits;
+    }
+}
+
+/**
+ * \fn bool ouvrirCadre(tAnalyse *analyse, int numCase, int valeur)
+ * \brief Ouvre un choix sous le dernier choix ouvert (TRACE_CHOIX)
+ * \param analyse Analyse de la trace d un thread
+ * \param numCase Case du choix
+ * \param valeur Valeur essayee
+ *
+ * \return false si la profondeur depasse celle de la plus grande grille (trace invalide)
+*/
+bool ouvrirCadre(tAnalyse *analyse, int numCase, int valeur) {
+    int taille_grille = analyse->tailleBloc*analyse->tailleBloc;
+    tCadre *parent = &analyse->cadres[analyse->profondeur];
+    tCadre *cadre;
+
+    if (analyse->profondeur == PROFONDEUR_TRACE_MAX || taille_grille == 0) {
+        return false;
+    }
+    analyse->evenements++;
+    analyse->noeuds++;
+    analyse->profondeur++;
+    if (analyse->profondeur > analyse->profondeurMax) {
+        analyse->profondeurMax = analyse->profondeur;
+        analyse->noeudsProfondeur[analyse->profondeur] = 0;
+        analyse->singletonsProfondeur[analyse->profondeur] = 0;
+    }
+    analyse->noeudsProfondeur[analyse->profondeur]++;
+
+    cadre = &analyse->cadres[analyse->profondeur];
+    cadre->numCase = numCase;
+    cadre->valeur = valeur;
+    cadre->debut = analyse->evenements - 1;
+    cadre->propres = 0;
+    cadre->finChemin = parent->finChemin;
+    if (analyse->profondeur <= PROFONDEUR_PILES) {
+        cadre->finChemin += (size_t) snprintf(analyse->chemin + parent->finChemin,
+                                              sizeof(analyse->chemin) - parent->finChemin, ";r%dc%d=%d",
+                                              numCase / taille_grille + 1, numCase % taille_grille + 1, valeur);
+    }
+    return true;
+}
+
+/**
+ * \fn void fermerCadre(tAnalyse *analyse, FILE *piles, bool abandon)
+ * \brief Ferme le dernier choix ouvert
+ * \param analyse Analyse de la trace d un thread
+ * \param piles Fichier des piles repliees, ou NULL
+ * \param abandon true si le choix a echoue (TRACE_RETOUR) : son sous-arbre est alors
+ * garde s il est parmi les NB_SOUS_ARBRES plus couteux de la grille
+ *
+ * La ligne de pile repliee du choix ("grille;r1c3=4;r2c7=1 poids") a pour poids le
+ * choix lui-meme et ses singletons : la somme des lignes d un sous-arbre est son cout.
+ * Au-dela de PROFONDEUR_PILES, ce poids est ajoute a celui du choix parent.
+*/
+void fermerCadre(tAnalyse *analyse, FILE *piles, bool abandon) {
+    static char chemin[16*PROFONDEUR_TRACE_MAX];
+    tCadre *cadre = &analyse->cadres[analyse->profondeur];
+    long cout = analyse->evenements - cadre->debut;
+    int rang;
+
+    if (abandon) {
+        // insertion parmi les sous-arbres les plus couteux, du plus au moins couteux
+        rang = analyse->nbPires;
+        while (rang > 0 && analyse->pires[rang - 1].cout < cout) {
+            rang--;
+        }
+        if (rang < NB_SOUS_ARBRES) {
+            if (analyse->nbPires == NB_SOUS_ARBRES) {
+                free(analyse->pires[NB_SOUS_ARBRES - 1].chemin);
+            } else {
+                analyse->nbPires++;
+            }
+            memmove(&analyse->pires[rang + 1], &analyse->pires[rang], (analyse->nbPires - 1 - rang) * sizeof(tSousArbre));
+            nommerCadres(analyse, analyse->profondeur, " > ", chemin, sizeof(chemin));
+            analyse->pires[rang].cout = cout;
+            analyse->pires[rang].profondeur = analyse->profondeur;
+            analyse->pires[rang].chemin = strdup(chemin);
+        }
+    }
+    if (piles != NULL && analyse->profondeur > PROFONDEUR_PILES) {
+        analyse->cadres[analyse->profondeur - 1].propres += cadre->propres + 1;
+    } else if (piles != NULL) {
+        fwrite(analyse->nom, 1, strlen(analyse->nom), piles);
+        fwrite(analyse->chemin, 1, cadre->finChemin, piles);
+        fprintf(piles, " %ld\n", cadre->propres + 1);
+    }
+    analyse->profondeur--;
+}
+
+/**
+ * \fn void terminerGrille(tAnalyse *analyse, FILE *sortie, FILE *piles)
+ * \brief Ferme les choix encore ouverts d une grille et ecrit son resume
+ * \param analyse Analyse de la trace d un thread
+ * \param sortie Flux ou ecrire le resume
+ * \param piles Fichier des piles repliees, ou NULL
+ *
+ * Le resume donne, pour chaque profondeur, le nombre de choix, le facteur de
+ * branchement (choix de la profondeur suivante par choix de celle-ci) et les
+ * singletons deduits, puis les sous-arbres abandonnes les plus couteux.
+*/
+void terminerGrille(tAnalyse *analyse, FILE *sortie, FILE *piles) {
+    while (analyse->profondeur > 0) {
+        fermerCadre(analyse, piles, false);
+    }
+    if (piles != NULL && analyse->cadres[0].propres > 0) {
+        fprintf(piles, "%s %ld\n", analyse->nom, analyse->cadres[0].propres);
+    }
+
+    fprintf(sortie, "grille %s (n = %d) : %ld noeuds, %ld retours, %ld solution%s, profondeur %d\n",
+            analyse->nom, analyse->tailleBloc, analyse->noeuds, analyse->retours, analyse->solutions,
+            analyse->solutions > 1 ? "s" : "", analyse->profondeurMax);
+    fprintf(sortie, "  singletons :");
+    // les techniques suivantes ne font que retirer des candidats, ou choisir
+    for (int t = 0; t <= TECHNIQUE_PROPAGATION_CACHEE; t++) {
+        fprintf(sortie, " %s %ld%s", NOMS_TECHNIQUES[t], analyse->singletons[t],
+                t < TECHNIQUE_PROPAGATION_CACHEE ? "," : "\n");
+    }
+    fprintf(sortie, "  profondeur      noeuds  branchement  singletons\n");
+    for (int p = 0; p <= analyse->profondeurMax; p++) {
+        fprintf(sortie, "  %10d  %10ld  %11.2f  %10ld\n", p, analyse->noeudsProfondeur[p],
+                p < analyse->profondeurMax ? (double) analyse->noeudsProfondeur[p + 1] / analyse->noeudsProfondeur[p] : 0.0,
+                analyse->singletonsProfondeur[p]);
+    }
+    if (analyse->nbPires > 0) {
+        fprintf(sortie, "  sous-arbres abandonnes les plus couteux (choix et singletons) :\n");
+    }
+    for (int i = 0; i < analyse->nbPires; i++) {
+        fprintf(sortie, "  %10ld  profondeur %d : %s\n", analyse->pires[i].cout, analyse->pires[i].profondeur,
+                analyse->pires[i].chemin);
+        free(analyse->pires[i].chemin);
+    }
+    analyse->nbPires = 0;
+    analyse->enCours = false;
+}
+
+/**
+ * \fn tAnalyse *creerAnalyse(void)
+ * \brief Alloue l etat d analyse de la trace d un thread
+ *
+ * \return Etat d analyse, NULL si la memoire manque
+*/
+tAnalyse *creerAnalyse(void) {
+    tAnalyse *analyse = calloc(1, sizeof(tAnalyse));
+
+    if (analyse != NULL) {
+        analyse->cadres = malloc((PROFONDEUR_TRACE_MAX + 1) * sizeof(tCadre));
+        analyse->noeudsProfondeur = malloc((PROFONDEUR_TRACE_MAX + 1) * sizeof(long));
+        analyse->singletonsProfondeur = malloc((PROFONDEUR_TRACE_MAX + 1) * sizeof(long));
+        if (analyse->cadres == NULL || analyse->noeudsProfondeur == NULL || analyse->singletonsProfondeur == NULL) {
+            libererAnalyse(analyse);
+            analyse = NULL;
+        }
+    }
+    return analyse;
+}
+
+/**
+ * \fn void libererAnalyse(tAnalyse *analyse)
+ * \brief Libere l etat d analyse de la trace d un thread
+ * \param analyse Etat d analyse, ou NULL
+*/
+void libererAnalyse(tAnalyse *analyse) {
+    if (analyse != NULL) {
+        for (int i = 0; i < analyse->nbPires; i++) {
+            free(analyse->pires[i].chemin);
+        }
+        free(analyse->cadres);
+        free(analyse->noeudsProfondeur);
+        free(analyse->singletonsProfondeur);
+        free(analyse);
+    }
+}
+
+/**
+ * \fn int analyserTrace(FILE *f, FILE *sortie, FILE *piles)
+ * \brief Reconstruit l arbre de recherche de chaque grille d une trace et le resume
+ * \param f Fichier de trace ouvert en lecture binaire
+ * \param sortie Flux ou ecrire le resume de chaque grille
+ * \param piles Fichier ou ecrire les piles repliees (format de flamegraph.pl), ou NULL
+ *
+ * \return Nombre de grilles analysees, -1 si le fichier n est pas une trace valide
+ *
+ * Les blocs sont lus un a un, et les evenements de chaque thread sont rejoues dans
+ * l ordre : les grilles sont resumees dans l ordre ou elles ont ete terminees.
+ * Une grille dont la trace est coupee (programme interrompu) est resumee jusqu au
+ * dernier evenement ecrit.
+*/
+int analyserTrace(FILE *f, FILE *sortie, FILE *piles) {
+    unsigned char entete[TAILLE_ENTETE_TRACE];
+    unsigned char enteteBloc[8];
+    unsigned char *bloc = malloc(TAILLE_TAMPON_TRACE);
+    tAnalyse **analyses = NULL;
+    tAnalyse **nouvelles;
+    tAnalyse *analyse;
+    uint32_t nbAnalyses = 0;
+    uint32_t numero, taille, mot;
+    size_t position, longueur;
+    int type, numCase, valeur;
+    int nbGrilles = 0;
+    bool valide = (bloc != NULL);
+    bool coupee = false;
+
+    valide = valide && fread(entete, 1, sizeof(entete), f) == sizeof(entete)
+          && memcmp(entete, MAGIE_TRACE, 4) == 0 && (entete[4] | entete[5] << 8) == VERSION_TRACE;
+
+    while (valide && !coupee && fread(enteteBloc, 1, 8, f) == 8) {
+        numero = 0;
+        taille = 0;
+        for (int i = 3; i >= 0; i--) {
+            numero = numero << 8 | enteteBloc[i];
+            taille = taille << 8 | enteteBloc[4 + i];
+        }
+        if (numero > 4096 || taille > TAILLE_TAMPON_TRACE || taille % 4 != 0) {
+            valide = false;
+            break;
+        }
+        position = fread(bloc, 1, taille, f);
+        if (position != taille) {
+            // dernier bloc coupe : ses evenements complets sont encore analyses
+            coupee = true;
+            taille = (uint32_t) (position / 4 * 4);
+        }
+        if (numero >= nbAnalyses) {
+            nouvelles = realloc(analyses, (numero + 1) * sizeof(tAnalyse *));
+            if (nouvelles == NULL) {
+                valide = false;
+                break;
+            }
+            analyses = nouvelles;
+            while (nbAnalyses <= numero) {
+                analyses[nbAnalyses++] = NULL;
+            }
+        }
+        if (analyses[numero] == NULL && (analyses[numero] = creerAnalyse()) == NULL) {
+            valide = false;
+            break;
+        }
+        analyse = analyses[numero];
+
+        for (position = 0; position < taille && valide; position += 4) {
+            mot = (uint32_t) bloc[position] | (uint32_t) bloc[position + 1] << 8
+                | (uint32_t) bloc[position + 2] << 16 | (uint32_t) bloc[position + 3] << 24;
+            type = mot & 7;
+            numCase = (mot >> 6) & 0xFFF;
+            valeur = (mot >> 18) & 0x7F;
+
+            if (type == TRACE_GRILLE) {
+                if (analyse->enCours) {
+                    terminerGrille(analyse, sortie, piles);
+                    nbGrilles++;
+                }
+                longueur = mot >> 7;
+                if (longueur > TAILLE_NOM_TRACE || position + 4 + longueur > taille) {
+                    valide = coupee;
+                    break;
+                }
+                memcpy(analyse->nom, bloc + position + 4, longueur);
+                analyse->nom[longueur] = '\0';
+                analyse->tailleBloc = (mot >> 3) & 0xF;
+                analyse->enCours = true;
+                analyse->profondeur = 0;
+                analyse->profondeurMax = 0;
+                analyse->evenements = 0;
+                analyse->noeuds = 0;
+                analyse->retours = 0;
+                analyse->solutions = 0;
+                memset(analyse->singletons, 0, sizeof(analyse->singletons));
+                analyse->cadres[0].propres = 0;
+                analyse->cadres[0].finChemin = 0;
+                analyse->noeudsProfondeur[0] = 1;
+                analyse->singletonsProfondeur[0] = 0;
+                position += (longueur + 3) / 4 * 4;
+            } else if (!analyse->enCours) {
+                valide = false;
+            } else if (type == TRACE_CHOIX) {
+                valide = ouvrirCadre(analyse, numCase, valeur);
+            } else if (type == TRACE_RETOUR) {
+                if (analyse->profondeur > 0) {
+                    analyse->retours++;
+                    fermerCadre(analyse, piles, true);
+                }
+            } else if (type == TRACE_SINGLETON) {
+                analyse->evenements++;
+                analyse->singletons[(mot >> 3) & 7]++;
+                analyse->singletonsProfondeur[analyse->profondeur]++;
+                analyse->cadres[analyse->profondeur].propres++;
+            } else if (type == TRACE_SOLUTION) {
+                analyse->solutions++;
+            } else if (type == TRACE_FIN) {
+                terminerGrille(analyse, sortie, piles);
+                nbGrilles++;
+            } else {
+                valide = false;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < nbAnalyses; i++) {
+        if (analyses[i] != NULL && analyses[i]->enCours) {
+            // trace coupee avant la fin de la grille
+            terminerGrille(analyses[i], sortie, piles);
+            nbGrilles++;
+        }
+        libererAnalyse(analyses[i]);
+    }
+    free(analyses);
+    free(bloc);
+    return valide ? nbGrilles : -1;
+}
\ No newline at end of file
@@ -0,0 +1,551 @@
+/**
+ * \file RESOLUTION-3.c
+ * \brief Programme de resolution de sudoku par Dancing Links (algorithme X de Knuth)
+ * \author PFRANGER Matheo, FAUCHET Malo
+ * \date 16 Octobre 2026
+ * \version 1.0
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * \def n
+ * \brief Taille d un bloc de la grille
+*/
+#define n 4
+
+/**
+ * \def TAILLE
+ * \brief Taille de la grille (n*n)
+*/
+#define TAILLE (n*n)
+
+/**
+ * \def NB_COLONNES
+ * \brief Nombre de contraintes de la matrice de couverture exacte
+ * 
+ * Quatre familles de TAILLE*TAILLE contraintes : chaque case contient une valeur,
+ * chaque ligne, chaque colonne et chaque bloc contient chaque valeur.
+*/
+#define NB_COLONNES (4*TAILLE*TAILLE)
+
+/**
+ * \def NB_LIGNES
+ * \brief Nombre de lignes de la matrice : un triplet (ligne, colonne, valeur) par ligne
+*/
+#define NB_LIGNES (TAILLE*TAILLE*TAILLE)
+
+/**
+ * \def NB_NOEUDS
+ * \brief Nombre de noeuds de la matrice : la racine, les en-tetes de colonne et 4 noeuds par ligne
+*/
+#define NB_NOEUDS (1 + NB_COLONNES + 4*NB_LIGNES)
+
+/**
+ * \def RACINE
+ * \brief Indice du noeud racine, qui relie les en-tetes des colonnes non couvertes
+*/
+#define RACINE 0
+
+
+// tGrille est un tableau de TAILLE lignes et TAILLE colonnes contenant la grille de jeu initiale
+typedef int tGrille[TAILLE][TAILLE];
+
+/**
+ * \struct tMatrice
+ * \brief Matrice creuse de couverture exacte chainee en Dancing Links
+ * 
+ * Tous les noeuds sont alloues une fois pour toutes dans des tableaux contigus,
+ * et designes par leur indice. Le noeud 0 est la racine, les noeuds 1 a NB_COLONNES
+ * sont les en-tetes de colonne, puis chaque ligne de la matrice occupe 4 noeuds consecutifs.
+ * 
+ * La structure tMatrice contient :
+ * - gauche, droite, haut, bas : les indices des noeuds voisins
+ * - colonne : l indice de l en-tete de colonne de chaque noeud
+ * - ligne : le numero de ligne de la matrice de chaque noeud
+ * - taille : le nombre de noeuds de chaque colonne
+ * - solution : les lignes choisies pendant la recherche, par profondeur
+*/
+typedef struct {
+    int gauche[NB_NOEUDS];
+    int droite[NB_NOEUDS];
+    int haut[NB_NOEUDS];
+    int bas[NB_NOEUDS];
+    int colonne[NB_NOEUDS];
+    int ligne[NB_NOEUDS];
+    int taille[NB_COLONNES + 1];
+    int solution[TAILLE*TAILLE];
+} tMatrice;
+
+
+/**
+ * \def CELLULE_VIDE
+ * \brief Caractere representant une cellule vide
+*/
+const char CELLULE_VIDE = '.' ;
+
+
+void initMatrice(tMatrice *matrice);
+void couvrirColonne(tMatrice *matrice, int col);
+void decouvrirColonne(tMatrice *matrice, int col);
+bool placerDonnee(tMatrice *matrice, int numLigne, int numColonne, int valeur);
+int choisirColonne(tMatrice *matrice);
+bool algorithmeX(tMatrice *matrice, int profondeur);
+bool dancingLinks(tMatrice *matrice, tGrille grille);
+
+char chargerGrille(tGrille grille);
+int nombreChiffre(int nombre);
+void afficherEspaces(int nombre_espaces);
+void afficherLigneSeparatrice(int nombre_espaces);
+void afficherGrille(tGrille grille);
+
+
+/*****************************************************
+ *                PROGRAMME PRINCIPAL                *
+ *****************************************************/
+
+int main() {
+    tGrille grille;
+    // la matrice est trop grosse pour la pile, elle est allouee statiquement
+    static tMatrice matrice;
+
+    chargerGrille(grille);
+
+    printf("Grille initial\n");
+    afficherGrille(grille);
+
+    clock_t start = clock();
+
+    bool resolue = dancingLinks(&matrice, grille);
+
+    clock_t end = clock();
+    double time_spent = (double)(end - start) / CLOCKS_PER_SEC;
+    
+    if (!resolue) {
+        printf("La grille n a pas de solution\n");
+    }
+    printf("Grille finale\n");
+    afficherGrille(grille);
+    printf("Resolution de la grille en %.6f secondes\n", time_spent);
+
+    return EXIT_SUCCESS;
+}
+
+/*****************************************************
+ *                  DANCING LINKS                    *
+ *****************************************************/
+
+/**
+ * \fn void initMatrice(tMatrice *matrice)
+ * \brief Construit la matrice de couverture exacte complete
+ * \param matrice Matrice a initialiser
+ * 
+ * Cette fonction chaine la racine et les en-tetes de colonne, puis ajoute
+ * une ligne par triplet (ligne, colonne, valeur). La ligne du triplet couvre
+ * quatre contraintes : sa case, la valeur dans sa ligne, la valeur dans sa
+ * colonne et la valeur dans son bloc. Ses quatre noeuds sont chaines en cercle
+ * et chacun est ajoute en bas de la colonne de sa contrainte.
+*/
+void initMatrice(tMatrice *matrice) {
+    int col, lig, c, v, bloc, r, k, noeud;
+    int contraintes[4];
+
+    // en-tetes : la racine et les colonnes forment une liste circulaire
+    for (col = 0; col <= NB_COLONNES; col++) {
+        matrice->gauche[col] = (col == 0) ? NB_COLONNES : col - 1;
+        matrice->droite[col] = (col == NB_COLONNES) ? 0 : col + 1;
+        matrice->haut[col] = col;
+        matrice->bas[col] = col;
+        matrice->colonne[col] = col;
+        matrice->ligne[col] = -1;
+        matrice->taille[col] = 0;
+    }
+
+    for (lig = 0; lig < TAILLE; lig++) {
+        for (c = 0; c < TAILLE; c++) {
+            bloc = (lig / n) * n + (c / n);
+            for (v = 0; v < TAILLE; v++) {
+                r = (lig*TAILLE + c)*TAILLE + v;
+                contraintes[0] = 1 + lig*TAILLE + c;
+                contraintes[1] = 1 + TAILLE*TAILLE + lig*TAILLE + v;
+                contraintes[2] = 1 + 2*TAILLE*TAILLE + c*TAILLE + v;
+                contraintes[3] = 1 + 3*TAILLE*TAILLE + bloc*TAILLE + v;
+
+                for (k = 0; k < 4; k++) {
+                    noeud = 1 + NB_COLONNES + 4*r + k;
+                    col = contraintes[k];
+
+                    // chainage horizontal des 4 noeuds de la ligne
+                    matrice->gauche[noeud] = 1 + NB_COLONNES + 4*r + (k+3)%4;
+                    matrice->droite[noeud] = 1 + NB_COLONNES + 4*r + (k+1)%4;
+
+                    // insertion en bas de la colonne
+                    matrice->colonne[noeud] = col;
+                    matrice->ligne[noeud] = r;
+                    matrice->bas[noeud] = col;
+                    matrice->haut[noeud] = matrice->haut[col];
+                    matrice->bas[matrice->haut[col]] = noeud;
+                    matrice->haut[col] = noeud;
+                    matrice->taille[col]++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \fn void couvrirColonne(tMatrice *matrice, int col)
+ * \brief Retire une colonne et toutes les lignes qui la couvrent
+ * \param matrice Matrice de couverture exacte
+ * \param col Indice de l en-tete de la colonne
+ * 
+ * La colonne est retiree de la liste des en-tetes, et chaque ligne ayant un noeud
+ * dans la colonne est retiree des autres colonnes. Les noeuds retires gardent
+ * leurs liens, ce qui permet a decouvrirColonne de les reinserer.
+*/
+void couvrirColonne(tMatrice *matrice, int col) {
+    int i, j;
+
+    matrice->droite[matrice->gauche[col]] = matrice->droite[col];
+    matrice->gauche[matrice->droite[col]] = matrice->gauche[col];
+    for (i = matrice->bas[col]; i != col; i = matrice->bas[i]) {
+        for (j = matrice->droite[i]; j != i; j = matrice->droite[j]) {
+            matrice->bas[matrice->haut[j]] = matrice->bas[j];
+            matrice->haut[matrice->bas[j]] = matrice->haut[j];
+            matrice->taille[matrice->colonne[j]]--;
+        }
+    }
+}
+
+/**
+ * \fn void decouvrirColonne(tMatrice *matrice, int col)
+ * \brief Reinsere une colonne retiree par couvrirColonne
+ * \param matrice Matrice de couverture exacte
+ * \param col Indice de l en-tete de la colonne
+ * 
+ * Les noeuds sont reinseres dans l ordre inverse de leur retrait.
+*/
+void decouvrirColonne(tMatrice *matrice, int col) {
+    int i, j;
+
+    for (i = matrice->haut[col]; i != col; i = matrice->haut[i]) {
+        for (j = matrice->gauche[i]; j != i; j = matrice->gauche[j]) {
+            matrice->taille[matrice->colonne[j]]++;
+            matrice->bas[matrice->haut[j]] = j;
+            matrice->haut[matrice->bas[j]] = j;
+        }
+    }
+    matrice->droite[matrice->gauche[col]] = col;
+    matrice->gauche[matrice->droite[col]] = col;
+}
+
+/**
+ * \fn bool placerDonnee(tMatrice *matrice, int numLigne, int numColonne, int valeur)
+ * \brief Retient la ligne de la matrice correspondant a une case deja remplie
+ * \param matrice Matrice de couverture exacte
+ * \param numLigne Numero de la ligne de la case
+ * \param numColonne Numero de la colonne de la case
+ * \param valeur Valeur de la case
+ * 
+ * \return false si une des contraintes de la case est deja couverte
+ * (la grille de depart contient deux fois la meme valeur dans une ligne, une colonne ou un bloc)
+ * 
+ * Une colonne est couverte quand son en-tete n est plus chaine a ses voisins.
+*/
+bool placerDonnee(tMatrice *matrice, int numLigne, int numColonne, int valeur) {
+    int r = (numLigne*TAILLE + numColonne)*TAILLE + (valeur - 1);
+    int premier = 1 + NB_COLONNES + 4*r;
+    int j;
+    bool valide = true;
+
+    j = premier;
+    do {
+        if (matrice->droite[matrice->gauche[matrice->colonne[j]]] != matrice->colonne[j]) {
+            valide = false;
+        }
+        j = matrice->droite[j];
+    } while (j != premier && valide);
+
+    if (valide) {
+        j = premier;
+        do {
+            couvrirColonne(matrice, matrice->colonne[j]);
+            j = matrice->droite[j];
+        } while (j != premier);
+    }
+    return valide;
+}
+
+/**
+ * \fn int choisirColonne(tMatrice *matrice)
+ * \brief Choisit la colonne non couverte ayant le moins de noeuds
+ * \param matrice Matrice de couverture exacte
+ * 
+ * \return Indice de l en-tete de la colonne choisie
+ * 
+ * Le parcours s arrete des qu une colonne a zero ou un seul noeud.
+*/
+int choisirColonne(tMatrice *matrice) {
+    int col;
+    int meilleure = matrice->droite[RACINE];
+
+    for (col = matrice->droite[RACINE]; col != RACINE && matrice->taille[meilleure] > 1; col = matrice->droite[col]) {
+        if (matrice->taille[col] < matrice->taille[meilleure]) {
+            meilleure = col;
+        }
+    }
+    return meilleure;
+}
+
+/**
+ * \fn bool algorithmeX(tMatrice *matrice, int profondeur)
+ * \brief Cherche une couverture exacte des colonnes restantes
+ * \param matrice Matrice de couverture exacte
+ * \param profondeur Nombre de lignes deja choisies pendant la recherche
+ * 
+ * \return true si une couverture a ete trouvee, false sinon
+ * 
+ * Cette fonction choisit la colonne la plus contrainte, la couvre, puis essaie
+ * chacune de ses lignes : la ligne est ajoutee a la solution, les autres colonnes
+ * qu elle couvre sont couvertes, et la recherche continue recursivement.
+ * Si elle echoue, les colonnes sont decouvertes dans l ordre inverse.
+*/
+bool algorithmeX(tMatrice *matrice, int profondeur) {
+    int col, r, j;
+    bool res = false;
+
+    if (matrice->droite[RACINE] == RACINE) {
+        // Toutes les contraintes sont couvertes, la grille est résolue
+        res = true;
+    } else {
+        col = choisirColonne(matrice);
+        if (matrice->taille[col] > 0) {
+            couvrirColonne(matrice, col);
+            for (r = matrice->bas[col]; r != col && !res; r = matrice->bas[r]) {
+                matrice->solution[profondeur] = matrice->ligne[r];
+                for (j = matrice->droite[r]; j != r; j = matrice->droite[j]) {
+                    couvrirColonne(matrice, matrice->colonne[j]);
+                }
+
+                res = algorithmeX(matrice, profondeur + 1);
+
+                for (j = matrice->gauche[r]; j != r; j = matrice->gauche[j]) {
+                    decouvrirColonne(matrice, matrice->colonne[j]);
+                }
+            }
+            decouvrirColonne(matrice, col);
+        }
+    }
+    return res;
+}
+
+/**
+ * \fn bool dancingLinks(tMatrice *matrice, tGrille grille)
+ * \brief Resout la grille de jeu par l algorithme X avec Dancing Links
+ * \param matrice Matrice de couverture exacte (ecrasee)
+ * \param grille Grille de jeu, completee si une solution existe
+ * 
+ * \return true si la grille est resolue, false sinon
+ * 
+ * Cette fonction construit la matrice, retient les lignes des cases deja
+ * remplies, puis recherche une couverture des contraintes restantes.
+ * Les lignes de la solution sont enfin reportees dans la grille.
+*/
+bool dancingLinks(tMatrice *matrice, tGrille grille) {
+    int i, j, r;
+    int nbCasesVides = 0;
+    bool res = true;
+
+    initMatrice(matrice);
+
+    for (i = 0; i < TAILLE && res; i++) {
+        for (j = 0; j < TAILLE && res; j++) {
+            if (grille[i][j] != 0) {
+                res = placerDonnee(matrice, i, j, grille[i][j]);
+            } else {
+                nbCasesVides++;
+            }
+        }
+    }
+
+    if (res) {
+        res = algorithmeX(matrice, 0);
+    }
+
+    if (res) {
+        for (i = 0; i < nbCasesVides; i++) {
+            r = matrice->solution[i];
+            grille[r / (TAILLE*TAILLE)][(r / TAILLE) % TAILLE] = r % TAILLE + 1;
+        }
+    }
+    return res;
+}
+
+/*****************************************************
+ *                  FONCTIONS AUTRES                 *
+ *****************************************************/
+
+/**
+ * \fn void chargerGrille(tGrille grille)
+ * \brief Charge une grille de jeu a partir d un fichier
+ * \param grille Grille de jeu a initialiser
+ * 
+ * \return Le charactere correspondant au numero de la grille
+ * La fonction charge une grille de jeu a partir d un fichier
+ * dont le nom est saisi au clavier.
+ * Cette fonction arrete le programme avec le code de sortie 1 
+ * si le dossier 'grilles/' n est pas present ou si le fichier n est pas trouve
+*/
+char chargerGrille(tGrille grille){
+    FILE * f;
+    char nomFichier[30];  /** \var nomFichier chaine de caracteres contenant le nom du fichier de grille a initialiser */
+    char numFic;  /** \var numFic le numero du fichier de grille a initialiser */
+
+    // test si le dossier ./grilles est present
+    if (access("./grilles", 0) == 0) {
+        
+        // choix du fichier a utiliser afin d initialiser la grille de jeu
+        printf("Choisissez un numéro de grille entre A et D : ");
+        scanf("%c", &numFic);
+
+        sprintf(nomFichier, "grilles/MaxiGrille%c.sud", numFic);
+
+        // utilisation du fichier
+        f = fopen(nomFichier, "rb");
+        if (f==NULL){
+            printf("ERREUR lors du chargement du fichier.\n");
+            printf("\tAssurez-vous que le dossier \'grilles/\' soit présent au même endroit que le programme,\n");
+            printf("\tet qu'il contienne les fichier \'MaxiGrille_.sud\', où \'_\' est un nombre entre de 1 à 10.\n");
+            exit(EXIT_FAILURE);
+        } else {
+            fread(grille, sizeof(int), TAILLE*TAILLE, f);
+        }
+        fclose(f);
+    } 
+    else {
+        printf("ERREUR. Le dossier \'grilles/\' est introuvable.\n");
+        printf("\tAssurez-vous que le dossier \'grilles/\' soit présent au même endroit que le programme,\n");
+        printf("\tet qu'il contienne les fichier \'MaxiGrille_.sud\', où \'_\' est un nombre entre de 1 à 10.\n");
+        exit(EXIT_FAILURE);
+    }
+    return numFic;
+}
+
+/**
+ * \fn int nombreChiffre(int nombre)
+ * \brief Determine le nombre de chiffres d un nombre
+ * \param nombre Nombre dont on veut connaitre le nombre de chiffres
+ * 
+ * \return Nombre de chiffres du nombre
+ * 
+ * Cette fonction calcule le nombre de chiffres d un nombre en
+ * divisant le nombre par 10 jusqu a ce que le nombre soit egal a 0.
+*/
+int nombreChiffre(int nombre) {
+    int nombre_chiffre_tmp = 0;
+    while (nombre != 0) {
+        nombre /= 10;
+        nombre_chiffre_tmp++;
+    }
+    return nombre_chiffre_tmp;
+}
+
+/**
+ * \fn void afficherEspaces(int nombre_espaces)
+ * \brief Affiche un nombre d espaces
+ * \param nombre_espaces Nombre d espaces a afficher
+*/
+void afficherEspaces(int nombre_espaces) {
+    for (int i=0; i < nombre_espaces; i++) {
+        printf(" ");
+    }
+}
+
+/**
+ * \fn void afficherLigneSeparatrice(nombre_espaces)
+ * \brief Affiche une ligne separatrice
+ * \param nombre_espaces Nombre d espaces a afficher
+ * 
+ * Affiche une ligne separatrice dont la taille est adaptative en fonction de la taille de la grille.
+ * Taille minimum de la grille : 1
+*/
+void afficherLigneSeparatrice(int nombre_espaces) {
+    afficherEspaces(nombre_espaces);
+    for (int i=0; i < n; i++) {
+        printf("+----");
+        for (int j=0; j < n-1; j++) {
+            printf("---");
+        }
+    }
+    printf("+\n");
+}
+
+/**
+ * \fn void afficherGrille(tGrille grille)
+ * \brief Affiche la grille de jeu de maniere lisible en fonction de TAILLE
+ * \param grille Grille de jeu a afficher
+ * 
+ * Cette fonction affiche la grille de jeu de maniere lisible en
+ * affichant les numeros des lignes et des colonnes, ainsi que les
+ * lignes et colonnes de separation entre les blocs de la grille.
+ * Les cellules vides sont representees par un point.
+ * La taille de la grille est adaptee en fonction de TAILLE.
+*/
+void afficherGrille(tGrille grille) {
+    int i, j, num_espaces; 
+
+    printf("\n");
+
+    // determine le nombre de chiffres dans le nombre le plus grand de la grille
+    num_espaces = nombreChiffre(TAILLE) + 1; /** \var nombre d espaces avant le debut de la grille */
+
+    // numeros des colonnes
+    afficherEspaces(num_espaces+1);
+    for (i = 0; i < TAILLE; i++) {
+        // check si i a atteint la fin d une region
+        if ((i%n == 0) && (i != 0)){
+            printf("  ");
+        }
+        printf("%3d", i+1);
+    }
+    printf("\n");
+
+    //affichage de la premiere ligne de separation
+    afficherLigneSeparatrice(num_espaces);
+
+
+    // corps de la grille + cote gauche
+    for (i=0; i < TAILLE; i++) {
+        //check si i a atteint la fin d une region
+        if ((i%n == 0) && (i != 0)){
+            afficherLigneSeparatrice(num_espaces);
+        }
+
+        // numeros des lignes
+        printf("%d", i+1);
+        afficherEspaces(num_espaces - nombreChiffre(i+1));
+        printf("%c", '|');
+
+        for (j=0; j < TAILLE; j++) {
+            // check si j a atteint la fin d une region
+            if ((j%n == 0) && (j != 0)){
+                printf("%2c",  '|' );
+            }
+
+            // affiche '.' au lieu de 0 pour les cellules vides
+            if (grille[i][j] == 0) {
+                printf("%3c", CELLULE_VIDE);
+            } else {
+                printf("%3d", grille[i][j]);
+            }
+        }
+        printf("%2c",  '|' );
+        printf("\n");
+    }
+    // derniere ligne
+    afficherLigneSeparatrice(num_espaces);
+}
\ No newline at end of file